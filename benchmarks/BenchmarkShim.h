@@ -0,0 +1,152 @@
+// Corvid20: A general-purpose C++20 library extending std.
+// https://github.com/stevensudit/Corvid20
+//
+// Copyright 2022-2024 Steven Sudit
+//
+// Licensed under the Apache License, Version 2.0(the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <string_view>
+
+#if defined(__x86_64__)
+#include <x86intrin.h>
+#endif
+
+// Minimal microbenchmark harness, in the same spirit as `AccutestShim.h`:
+// just enough to attach stable numbers to the string hot paths without
+// pulling in an external dependency.
+//
+// Each benchmark is a `void fn()` that builds its corpus, calls `run` on the
+// code under test, and passes the result to `report`. List the functions with
+// `MAKE_BENCHMARK_LIST` to generate `main`.
+namespace benchmark_shim {
+
+// Keep the compiler from optimizing away a computed value.
+template<typename T>
+inline void do_not_optimize(const T& value) {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// Force pending writes to be considered observed.
+inline void clobber_memory() { asm volatile("" ::: "memory"); }
+
+// Cycle counter where available; falls back to the monotonic clock so the
+// columns stay populated on other targets.
+inline uint64_t read_cycles() {
+#if defined(__x86_64__)
+  return __rdtsc();
+#else
+  return static_cast<uint64_t>(
+      std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+}
+
+// Deterministic pseudo-random source (SplitMix64) for building input
+// corpora. A fixed seed keeps runs comparable across builds and machines.
+class corpus_rng {
+public:
+  explicit constexpr corpus_rng(uint64_t seed = 0x9e37'79b9'7f4a'7c15ull)
+      : state_{seed} {}
+
+  constexpr uint64_t next() noexcept {
+    auto z = (state_ += 0x9e37'79b9'7f4a'7c15ull);
+    z = (z ^ (z >> 30)) * 0xbf58'476d'1ce4'e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d0'49bb'1331'11ebull;
+    return z ^ (z >> 31);
+  }
+
+  // Uniform-ish value in [0, bound); good enough for corpus generation.
+  constexpr uint64_t next_under(uint64_t bound) noexcept {
+    return next() % bound;
+  }
+
+  // Random text drawn from `alphabet`, for haystacks and pieces.
+  std::string next_text(size_t len,
+      std::string_view alphabet = "abcdefghijklmnopqrstuvwxyz ") {
+    std::string s;
+    s.reserve(len);
+    while (s.size() < len) s += alphabet[next_under(alphabet.size())];
+    return s;
+  }
+
+private:
+  uint64_t state_;
+};
+
+// Timing for one benchmark: best-of-batches per-operation cost. Taking the
+// minimum over several batches filters out scheduler and cache noise, which
+// only ever inflates a batch.
+struct result {
+  double ns_per_op{};
+  double cycles_per_op{};
+  uint64_t operations{};
+};
+
+// Time `fn`, which performs `ops_per_call` operations per invocation.
+// Calibrates the batch size so each batch runs long enough to swamp clock
+// overhead, then reports the fastest batch.
+template<typename FN>
+result run(FN&& fn, uint64_t ops_per_call = 1) {
+  using clock = std::chrono::steady_clock;
+  constexpr auto min_batch_time = std::chrono::milliseconds{2};
+  constexpr int batches = 9;
+
+  // Warm up and calibrate.
+  uint64_t batch = 1;
+  for (;;) {
+    const auto t0 = clock::now();
+    for (uint64_t i = 0; i < batch; ++i) fn();
+    if (clock::now() - t0 >= min_batch_time) break;
+    batch *= 2;
+  }
+
+  result best{};
+  uint64_t total_ops{};
+  for (int b = 0; b < batches; ++b) {
+    const auto c0 = read_cycles();
+    const auto t0 = clock::now();
+    for (uint64_t i = 0; i < batch; ++i) fn();
+    const auto t1 = clock::now();
+    const auto c1 = read_cycles();
+    const auto ops = batch * ops_per_call;
+    total_ops += ops;
+    const auto ns =
+        std::chrono::duration<double, std::nano>{t1 - t0}.count() / ops;
+    if (best.ns_per_op == 0 || ns < best.ns_per_op) {
+      best.ns_per_op = ns;
+      best.cycles_per_op = static_cast<double>(c1 - c0) / ops;
+    }
+  }
+  best.operations = total_ops;
+  return best;
+}
+
+inline void report(std::string_view name, const result& r) {
+  std::printf("%-40.*s %12.2f ns/op %14.1f cyc/op %12llu ops\n",
+      static_cast<int>(name.size()), name.data(), r.ns_per_op, r.cycles_per_op,
+      static_cast<unsigned long long>(r.operations));
+}
+
+} // namespace benchmark_shim
+
+#define MAKE_BENCHMARK_LIST(...)                                             \
+  int main() {                                                               \
+    const std::initializer_list<void (*)()> benchmarks{__VA_ARGS__};         \
+    std::printf("%-40s %15s %18s %16s\n", "benchmark", "time", "cycles",     \
+        "operations");                                                       \
+    for (const auto benchmark : benchmarks) benchmark();                     \
+    return 0;                                                                \
+  }
@@ -0,0 +1,194 @@
+// Corvid20: A general-purpose C++20 library extending std.
+// https://github.com/stevensudit/Corvid20
+//
+// Copyright 2022-2024 Steven Sudit
+//
+// Licensed under the Apache License, Version 2.0(the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../corvid/containers.h"
+#include "BenchmarkShim.h"
+
+using namespace std::literals;
+using namespace std::chrono_literals;
+using namespace corvid;
+using namespace benchmark_shim;
+
+// Benchmarks and contention tests for the hot containers: `intern_table`
+// insert/lookup across thread counts, `circular_buffer` push/pop throughput,
+// `timers` schedule/expire at increasing backlogs, and `extensible_arena`
+// allocation rates against plain `new`. The correctness tests live in
+// `tests/containers_test.cpp` and `tests/timers_test.cpp`; these exist to
+// make the scaling cliffs visible.
+
+enum class string_id { missing };
+
+template<>
+constexpr inline auto registry::enum_spec_v<string_id> =
+    sequence::make_sequence_enum_spec<string_id, "missing">();
+
+namespace {
+
+constexpr size_t shard_count = 8;
+constexpr size_t words_per_thread = 8'192;
+constexpr auto thread_counts = std::array<size_t, 6>{1, 2, 4, 8, 16, 32};
+
+using sharded_t = sharded_intern_table<std::string, string_id, shard_count>;
+
+// One slice of distinct words per potential thread, seeded so every run
+// interns the same corpus.
+std::vector<std::vector<std::string>> make_word_slices(size_t threads) {
+  corpus_rng rng{42};
+  std::vector<std::vector<std::string>> slices(threads);
+  for (size_t t = 0; t < threads; ++t) {
+    slices[t].reserve(words_per_thread);
+    for (size_t i = 0; i < words_per_thread; ++i)
+      slices[t].push_back(rng.next_text(4 + rng.next_under(12),
+                              "abcdefghijklmnopqrstuvwxyz") +
+                          std::to_string(t * words_per_thread + i));
+  }
+  return slices;
+}
+
+// Run `per_thread(t)` on `threads` threads and wait for them all.
+template<typename FN>
+void on_threads(size_t threads, FN&& per_thread) {
+  std::vector<std::jthread> pool;
+  pool.reserve(threads);
+  for (size_t t = 0; t < threads; ++t) pool.emplace_back(per_thread, t);
+}
+
+} // namespace
+
+void Bench_InternInsert() {
+  const auto slices = make_word_slices(thread_counts.back());
+  for (const auto threads : thread_counts) {
+    const auto r = run(
+        [&] {
+          auto table_ptr =
+              sharded_t::make(string_id{1}, string_id{2'000'000});
+          auto& table = *table_ptr;
+          on_threads(threads, [&](size_t t) {
+            for (const auto& word : slices[t]) {
+              const auto iv = table.intern(word);
+              do_not_optimize(iv.id());
+            }
+          });
+        },
+        threads * words_per_thread);
+    report("intern_table/insert/" + std::to_string(threads) + "t", r);
+  }
+}
+
+void Bench_InternLookup() {
+  const auto slices = make_word_slices(thread_counts.back());
+  auto table_ptr = sharded_t::make(string_id{1}, string_id{2'000'000});
+  auto& table = *table_ptr;
+  for (const auto& slice : slices)
+    for (const auto& word : slice) (void)table.intern(word);
+  for (const auto threads : thread_counts) {
+    const auto r = run(
+        [&] {
+          on_threads(threads, [&](size_t t) {
+            for (const auto& word : slices[t]) {
+              const auto iv = table.get(word);
+              do_not_optimize(iv.id());
+            }
+          });
+        },
+        threads * words_per_thread);
+    report("intern_table/lookup/" + std::to_string(threads) + "t", r);
+  }
+}
+
+void Bench_CircularBuffer() {
+  std::vector<uint64_t> storage(1024);
+  circular_buffer cb{storage};
+  for (uint64_t i = 0; i < storage.size() / 2; ++i) cb.push_back(i);
+  report("circular_buffer/push-pop", run([&] {
+    uint64_t total{};
+    for (uint64_t i = 0; i < 1024; ++i) {
+      cb.push_back(i);
+      total += cb.pop_front();
+    }
+    do_not_optimize(total);
+  }, 1024));
+}
+
+void Bench_SpscCircularBuffer() {
+  constexpr uint64_t per_pass = 1 << 18;
+  std::vector<uint64_t> storage(1024);
+  pow2_spsc_circular_buffer<uint64_t> buf{storage};
+  report("spsc_circular_buffer/2t", run([&] {
+    std::jthread producer{[&] {
+      for (uint64_t i = 0; i < per_pass; ++i)
+        while (!buf.try_push(i)) std::this_thread::yield();
+    }};
+    uint64_t total{};
+    for (uint64_t i = 0; i < per_pass; ++i) {
+      uint64_t value;
+      while (!buf.try_pop(value)) std::this_thread::yield();
+      total += value;
+    }
+    do_not_optimize(total);
+  }, per_pass));
+}
+
+void Bench_Timers() {
+  for (const size_t outstanding :
+      {10'000uz, 100'000uz, 1'000'000uz, 2'000'000uz}) {
+    const auto r = run(
+        [&] {
+          timers t;
+          auto now = std::chrono::steady_clock::time_point{};
+          t.set_clock_callback([&now] { return now; });
+          size_t fired{};
+          auto cb = [&fired](timer_event&) { ++fired; };
+          for (size_t i = 0; i < outstanding; ++i) (void)t.set(30s, cb);
+          now += 60s;
+          (void)t.tick();
+          do_not_optimize(fired);
+        },
+        outstanding);
+    report("timers/schedule+expire/" + std::to_string(outstanding), r);
+  }
+}
+
+void Bench_ArenaAlloc() {
+  struct payload {
+    uint64_t a[8];
+  };
+  constexpr size_t count = 8'192;
+  report("arena/new-64B", run([&] {
+    extensible_arena arena{1 << 20};
+    extensible_arena::scope s{arena};
+    const payload* last{};
+    for (size_t i = 0; i < count; ++i) last = arena::arena_new<payload>();
+    do_not_optimize(last);
+  }, count));
+  std::vector<payload*> raw(count);
+  report("std-new/new-64B", run([&] {
+    for (size_t i = 0; i < count; ++i) raw[i] = new payload{};
+    do_not_optimize(raw.data());
+    for (auto* p : raw) delete p;
+  }, count));
+}
+
+MAKE_BENCHMARK_LIST(Bench_InternInsert, Bench_InternLookup,
+    Bench_CircularBuffer, Bench_SpscCircularBuffer, Bench_Timers,
+    Bench_ArenaAlloc);
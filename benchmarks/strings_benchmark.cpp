@@ -0,0 +1,140 @@
+// Corvid20: A general-purpose C++20 library extending std.
+// https://github.com/stevensudit/Corvid20
+//
+// Copyright 2022-2024 Steven Sudit
+//
+// Licensed under the Apache License, Version 2.0(the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../corvid/strings.h"
+#include "BenchmarkShim.h"
+
+using namespace std::literals;
+using namespace corvid;
+using namespace benchmark_shim;
+
+// Benchmarks for the string hot paths: locate, substitute, split, join and
+// parse_num. Corpora are randomized but seeded, so numbers are comparable
+// from run to run; each benchmark folds its answer into a sink that is fed to
+// `do_not_optimize` so the work cannot be elided.
+
+namespace {
+
+// Random haystack with `plants` copies of `needle` scattered through it.
+std::string make_haystack(size_t len, std::string_view needle, size_t plants) {
+  corpus_rng rng{42};
+  auto s = rng.next_text(len);
+  for (size_t i = 0; i < plants; ++i)
+    s.replace(rng.next_under(len - needle.size()), needle.size(), needle);
+  return s;
+}
+
+} // namespace
+
+void Bench_LocateChar() {
+  const auto haystack = make_haystack(64 * 1024, "#", 64);
+  report("locate/char/64KiB", run([&] {
+    size_t hits{};
+    for (auto pos = strings::locate(haystack, '#'); pos != strings::npos;
+         pos = strings::locate(haystack, '#', pos + 1))
+      ++hits;
+    do_not_optimize(hits);
+  }));
+}
+
+void Bench_LocateString() {
+  const auto haystack = make_haystack(64 * 1024, "qzkwx", 64);
+  report("locate/string/64KiB", run([&] {
+    size_t hits{};
+    for (auto pos = strings::locate(haystack, "qzkwx"sv);
+         pos != strings::npos;
+         pos = strings::locate(haystack, "qzkwx"sv, pos + 1))
+      ++hits;
+    do_not_optimize(hits);
+  }));
+}
+
+void Bench_LocateAnyChar() {
+  const auto haystack = make_haystack(64 * 1024, "#", 64);
+  static constexpr char value_chars[] = {'#', '%', '@'};
+  constexpr std::span<const char> values{value_chars};
+  report("locate/any-of-3-chars/64KiB", run([&] {
+    size_t hits{};
+    for (auto loc = strings::locate(haystack, values);
+         loc.pos != strings::npos;
+         loc = strings::locate(haystack, values, loc.pos + 1))
+      ++hits;
+    do_not_optimize(hits);
+  }));
+}
+
+void Bench_Substitute() {
+  const auto original = make_haystack(4 * 1024, "qz", 128);
+  report("substitute/2-char/4KiB", run([&] {
+    auto s = original;
+    const auto n = strings::substitute(s, "qz"sv, "zq"sv);
+    do_not_optimize(n);
+    do_not_optimize(s);
+  }));
+}
+
+void Bench_Split() {
+  corpus_rng rng{42};
+  std::string csv;
+  for (size_t i = 0; i < 1024; ++i) {
+    if (!csv.empty()) csv += ',';
+    csv += rng.next_text(1 + rng.next_under(12), "abcdefghij");
+  }
+  report("split/1024-pieces", run([&] {
+    const auto parts = strings::split(csv, ","sv);
+    do_not_optimize(parts.size());
+  }));
+  report("split_range/1024-pieces", run([&] {
+    size_t total{};
+    for (const auto piece : strings::split_range(csv, ","sv))
+      total += piece.size();
+    do_not_optimize(total);
+  }));
+}
+
+void Bench_Join() {
+  corpus_rng rng{42};
+  std::vector<std::string> parts;
+  for (size_t i = 0; i < 1024; ++i)
+    parts.push_back(rng.next_text(1 + rng.next_under(12), "abcdefghij"));
+  report("join_with/1024-pieces", run([&] {
+    const auto s = strings::join_with<strings::join_opt::flat>(", ", parts);
+    do_not_optimize(s.size());
+  }));
+}
+
+void Bench_ParseNum() {
+  corpus_rng rng{42};
+  std::vector<std::string> numbers;
+  for (size_t i = 0; i < 1024; ++i)
+    numbers.push_back(std::to_string(
+        static_cast<int64_t>(rng.next()) >> rng.next_under(40)));
+  report("parse_num/int64", run([&] {
+    int64_t total{};
+    for (const auto& n : numbers)
+      total += strings::parse_num<int64_t>(n).value_or(0);
+    do_not_optimize(total);
+  }, numbers.size()));
+}
+
+MAKE_BENCHMARK_LIST(Bench_LocateChar, Bench_LocateString, Bench_LocateAnyChar,
+    Bench_Substitute, Bench_Split, Bench_Join, Bench_ParseNum);
@@ -48,4 +48,40 @@ for file in *; do
 done
 
 # Navigate back to the original directory after building
-cd ..
+cd ../..
+
+# Define the benchmark build directory
+benchBuildDir="benchmarks/release_bin"
+
+# If the benchmark build directory exists, delete it to clean the build
+if [ -d "$benchBuildDir" ]; then
+    echo "Cleaning the benchmark build directory..."
+    rm -rf "$benchBuildDir"
+fi
+
+# Create the benchmark build directory
+mkdir -p "$benchBuildDir"
+
+# Navigate to the benchmark build directory
+cd "$benchBuildDir" || exit
+
+# Run cmake to configure the benchmarks with Ninja and clang
+cmake -G "Ninja" ..
+
+# Run the build (this will compile everything from scratch)
+cmake --build .. --config Release
+
+# Benchmarks are built unconditionally but only run when asked, since they
+# take a while and their numbers only matter when you're comparing them.
+if [[ "$1" == "--bench" ]]; then
+  for file in *; do
+    if [[ -x "$file" && -f "$file" ]]; then
+      echo "Executing $file..."
+      ./"$file"
+      echo "$file finished execution."
+    fi
+  done
+fi
+
+# Navigate back to the original directory after building
+cd ../..
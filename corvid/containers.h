@@ -20,11 +20,17 @@
 #include "containers/optional_ptr.h"
 #include "containers/opt_find.h"
 #include "containers/own_ptr.h"
+#include "containers/handle_pool.h"
 #include "containers/ranges.h"
 #include "containers/transparent.h"
+#include "containers/flat_map.h"
 #include "containers/interval.h"
+#include "containers/interval_set.h"
+#include "containers/enum_map.h"
 #include "containers/indirect_key.h"
 #include "containers/sync_lock.h"
 #include "containers/intern.h"
+#include "containers/intern_snapshot.h"
+#include "containers/inplace_function.h"
 #include "containers/circular_buffer.h"
 #include "containers/timers.h"
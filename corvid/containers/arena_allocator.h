@@ -16,9 +16,91 @@
 // limitations under the License.
 #pragma once
 #include "containers_shared.h"
+#include "sync_lock.h"
+#include "../instrument.h"
+#include <cassert>
+
+#if __has_include(<sys/mman.h>)
+#define CORVID_HAS_MMAP
+#include <sys/mman.h>
+#endif
 
 namespace corvid { inline namespace container { namespace arena {
 
+#ifdef CORVID_HAS_MMAP
+
+// A large virtual address range, reserved up front and committed lazily,
+// for backing `extensible_arena` blocks.
+//
+// Blocks from the default allocator fragment the heap and sit on 4KB
+// pages, so walks over a large arena burn a TLB entry per page. Reserving
+// one contiguous range with `mmap` and asking for huge pages (2MB on
+// x86-64) cuts the entries needed by three orders of magnitude, and since
+// the reservation is `MAP_NORESERVE` and pages are committed by the first
+// touch, an oversized reservation costs only address space. An arena
+// backed by one also grows contiguously, without a copy, ever.
+//
+// Huge pages are a request, not a demand: the range is flagged with
+// `MADV_HUGEPAGE`, so the kernel backs it with transparent huge pages when
+// it can and plain pages when it can't. We deliberately don't use
+// `MAP_HUGETLB`, because a hugetlbfs mapping succeeds even when the pool
+// is empty and then delivers SIGBUS on first touch, which a lazily
+// committed reservation would turn into a delayed crash.
+class page_reserve {
+public:
+  static constexpr size_t huge_page_size = 2 << 20;
+
+  explicit page_reserve(size_t reserve_bytes) noexcept
+      : capacity_{round_up(reserve_bytes, huge_page_size)} {
+    base_ = ::mmap(nullptr, capacity_, PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (base_ == MAP_FAILED) {
+      base_ = nullptr;
+      capacity_ = 0;
+      return;
+    }
+#ifdef MADV_HUGEPAGE
+    ::madvise(base_, capacity_, MADV_HUGEPAGE);
+#endif
+  }
+
+  page_reserve(const page_reserve&) = delete;
+  page_reserve& operator=(const page_reserve&) = delete;
+
+  ~page_reserve() {
+    if (base_) ::munmap(base_, capacity_);
+  }
+
+  // Carve `n` bytes off the reservation, or `nullptr` when it's exhausted
+  // (or the mapping failed). Never returns memory to the range; the whole
+  // reservation is released at destruction.
+  [[nodiscard]] void* take(size_t n, size_t align) noexcept {
+    const auto start = round_up(size_, align);
+    if (!base_ || start + n > capacity_) return nullptr;
+    size_ = start + n;
+    return static_cast<std::byte*>(base_) + start;
+  }
+
+  // Bytes handed out so far, and the full reserved size. Committed memory
+  // is whatever has actually been touched, not `size`.
+  [[nodiscard]] size_t size() const noexcept { return size_; }
+  [[nodiscard]] size_t capacity() const noexcept { return capacity_; }
+
+  // Whether the mapping succeeded at all.
+  [[nodiscard]] explicit operator bool() const noexcept { return base_; }
+
+private:
+  static constexpr size_t round_up(size_t n, size_t align) noexcept {
+    return (n + align - 1) & ~(align - 1);
+  }
+
+  void* base_{};
+  size_t capacity_{};
+  size_t size_{};
+};
+
+#endif // CORVID_HAS_MMAP
+
 // Arena implemented as a singly-linked list of blocks.
 //
 // To use:
@@ -36,7 +118,8 @@ namespace corvid { inline namespace container { namespace arena {
 //
 // Allocates new blocks as needed, chaining them together. Block size is
 // constant, except when it must be enlarged to satisfy an allocation. Only
-// frees when the entire arena is destroyed.
+// frees when the entire arena is destroyed, but `reset` and `mark`/`rewind`
+// allow the block chain to be reused across request scopes without freeing.
 //
 // If you make a container that uses an `arena_allocator`, it will still try to
 // destruct and free all of its elements. The free is a no-op, but pointless.
@@ -58,25 +141,29 @@ class extensible_arena {
   struct list_node;
   struct list_node_deleter {
     void operator()(list_node* node) const noexcept {
+      const bool mapped = node->mapped_;
       // Destructs `next_` recursively.
       node->~list_node();
-      delete[] reinterpret_cast<char*>(node);
+      // Mapped nodes live inside a `page_reserve`, which reclaims them
+      // wholesale when it is destroyed.
+      if (!mapped) delete[] reinterpret_cast<char*>(node);
     }
   };
   using pointer = std::unique_ptr<list_node, list_node_deleter>;
 
-  // Points to the head owned by the active container. Use
+  // Points to the arena installed by the active container. Use
   // `extensible_arena::scope` to install whenever an allocation is needed.
-  thread_local static inline pointer* tls_head_;
+  thread_local static inline extensible_arena* tls_arena_;
 
-  static auto& get_head() {
-    assert(tls_head_);
-    return *tls_head_;
+  static auto& get_arena() {
+    assert(tls_arena_);
+    return *tls_arena_;
   }
 
   struct list_node {
     size_t capacity_{};
     size_t size_{};
+    bool mapped_{};
     pointer next_;
     std::byte data_[1];
 
@@ -109,45 +196,388 @@ class extensible_arena {
     }
   };
 
-  // Allocate a block of size `n` with `align` alignment. If no room at `head`,
-  // replaces with new block, chaining the rest.
-  static void* allocate(pointer& head, size_t n, size_t align) {
-    if (auto start = head->allocate(n, align)) return start;
-    auto new_head = list_node::make(std::max(head->capacity_, n));
-    new_head->next_ = std::move(head);
-    head = std::move(new_head);
-    return head->allocate(n, align);
+  // Allocate a block of size `n` with `align` alignment. If no room at the
+  // head, rotates in an empty chained block (left behind by `reset` or
+  // `rewind`) when one fits, and otherwise replaces the head with a new
+  // block, chaining the rest.
+  void* do_allocate(size_t n, size_t align) {
+    CORVID_INSTRUMENT_RECORD(arena_alloc_bytes, n);
+    const auto before = head_->size_;
+    if (auto start = head_->allocate(n, align)) {
+      note_allocation(n, head_->size_ - before);
+      return start;
+    }
+    note_tail_waste(head_->capacity_ - head_->size_);
+    if (auto* next = head_->next_.get();
+        next && next->size_ == 0 && n <= next->capacity_)
+    {
+      auto empty = std::move(head_->next_);
+      head_->next_ = std::move(empty->next_);
+      empty->next_ = std::move(head_);
+      head_ = std::move(empty);
+    } else {
+      auto new_head = make_node(std::max(head_->capacity_, n));
+      new_head->next_ = std::move(head_);
+      head_ = std::move(new_head);
+      note_new_block();
+    }
+    auto start = head_->allocate(n, align);
+    note_allocation(n, head_->size_);
+    return start;
+  }
+
+  // Make a new node of `capacity`, carving it out of the backing reserve
+  // when one is installed and has room, and falling back to the heap
+  // otherwise. Reserve-backed nodes are contiguous with their predecessors,
+  // so growth never fragments the range.
+  pointer make_node(size_t capacity) {
+#ifdef CORVID_HAS_MMAP
+    if (reserve_) {
+      if (auto* buffer = reserve_->take(
+              list_node::calculate_total_size(capacity), alignof(list_node)))
+      {
+        auto node = pointer{new (buffer) list_node{}};
+        node->capacity_ = capacity;
+        node->mapped_ = true;
+        return node;
+      }
+    }
+#endif
+    return list_node::make(capacity);
   }
 
+#ifdef CORVID_HAS_MMAP
+  // Must precede `head_` so it's set before the initial `make_node` call.
+  page_reserve* reserve_{};
+#endif
   pointer head_;
 
 public:
   explicit extensible_arena(size_t capacity) noexcept
       : head_{list_node::make(capacity)} {}
 
+#ifdef CORVID_HAS_MMAP
+  // Back the arena's blocks with `reserve`, which must outlive it. Blocks
+  // fall back to the heap once the reserve runs dry, so exhaustion degrades
+  // performance rather than failing.
+  extensible_arena(size_t capacity, page_reserve& reserve) noexcept
+      : reserve_{&reserve}, head_{make_node(capacity)} {}
+#endif
+
   static void* allocate(size_t n, size_t align) {
-    return allocate(get_head(), n, align);
+    return get_arena().do_allocate(n, align);
+  }
+
+  // Allocation statistics, tracked only when `CORVID_ARENA_STATS` is
+  // defined; otherwise `stats` returns zeroes and the accounting is compiled
+  // out. Counts are cumulative over the arena's lifetime, except
+  // `high_water`, which is the peak of bytes in use at once and survives
+  // `reset` and `rewind`; it's the number to size the capacity from.
+  struct stats_t {
+    // Bytes asked of the allocator, excluding padding.
+    size_t bytes_requested{};
+    // Alignment padding plus block tails abandoned on rollover.
+    size_t bytes_wasted{};
+    // Blocks allocated, including the initial one.
+    size_t blocks{};
+    // Peak bytes in use at once, padding included.
+    size_t high_water{};
+  };
+
+  [[nodiscard]] stats_t stats() const noexcept {
+#ifdef CORVID_ARENA_STATS
+    return stats_;
+#else
+    return {};
+#endif
+  }
+
+  // Opaque bookmark into the arena. Get one from `mark` and give it back to
+  // `rewind`; don't touch the insides.
+  struct marker {
+    list_node* node_{};
+    size_t size_{};
+  };
+
+  // Rewind all bump pointers, retaining the block chain, so steady-state
+  // reuse does no allocation at all. Everything previously allocated from
+  // the arena is implicitly freed; nothing is destructed.
+  void reset() noexcept {
+    for (auto* node = head_.get(); node; node = node->next_.get())
+      node->size_ = 0;
+    recount_in_use();
+  }
+
+  // Capture the current position, for a later `rewind`.
+  [[nodiscard]] marker mark() const noexcept {
+    return {head_.get(), head_->size_};
+  }
+
+  // Rewind to a position captured by `mark`, implicitly freeing everything
+  // allocated since. Blocks added in the interim are retained, empty, for
+  // reuse. The marker must come from this arena and still be pending; nested
+  // rewinds must unwind innermost-first.
+  void rewind(const marker& m) noexcept {
+    auto* node = head_.get();
+    for (; node && node != m.node_; node = node->next_.get()) node->size_ = 0;
+    assert(node);
+    node->size_ = m.size_;
+    recount_in_use();
   }
 
   static bool contains(const void* pv) {
-    for (auto next = get_head().get(); next; next = next->next_.get())
+    for (auto next = get_arena().head_.get(); next; next = next->next_.get())
       if (next->data_ <= pv && pv < next->data_ + next->size_) return true;
 
     return false;
   }
 
-  // Sets thread-local scope for arena.
+  // Sets thread-local scope for arena. Note that destruction leaves the
+  // arena installed, by design: the caller of an arena-owning container can
+  // then inspect what its methods allocated, as with `contains`.
   class scope {
   public:
-    explicit scope(extensible_arena& arena) noexcept : old_head{&arena.head_} {
-      tls_head_ = &arena.head_;
+    explicit scope(extensible_arena& arena) noexcept : old_arena_{&arena} {
+      tls_arena_ = &arena;
     }
 
-    ~scope() noexcept { tls_head_ = old_head; }
+    ~scope() noexcept { tls_arena_ = old_arena_; }
 
   private:
-    pointer* old_head;
+    // Volatile so that the destructor's store isn't flagged as leaving a
+    // dangling pointer installed; doing so is this class's entire job.
+    extensible_arena* volatile old_arena_;
   };
+
+private:
+#ifdef CORVID_ARENA_STATS
+  stats_t stats_{.blocks = 1};
+  size_t in_use_{};
+#endif
+
+  void note_allocation([[maybe_unused]] size_t requested,
+      [[maybe_unused]] size_t consumed) noexcept {
+#ifdef CORVID_ARENA_STATS
+    stats_.bytes_requested += requested;
+    stats_.bytes_wasted += consumed - requested;
+    in_use_ += consumed;
+    if (in_use_ > stats_.high_water) stats_.high_water = in_use_;
+#endif
+  }
+
+  void note_tail_waste([[maybe_unused]] size_t tail) noexcept {
+#ifdef CORVID_ARENA_STATS
+    stats_.bytes_wasted += tail;
+#endif
+  }
+
+  void note_new_block() noexcept {
+#ifdef CORVID_ARENA_STATS
+    ++stats_.blocks;
+#endif
+  }
+
+  void recount_in_use() noexcept {
+#ifdef CORVID_ARENA_STATS
+    in_use_ = 0;
+    for (auto* node = head_.get(); node; node = node->next_.get())
+      in_use_ += node->size_;
+#endif
+  }
+};
+
+// Pool of arenas with per-thread binding.
+//
+// Each thread that enters an `arena_pool::scope` (or calls `local` directly)
+// is lazily handed its own `extensible_arena`, so workers bump-allocate with
+// no contention; the pool lock is only taken the first time a thread shows
+// up. The same `arena_allocator`/`arena_string` aliases work unchanged,
+// since they go through the thread-local scope mechanism.
+//
+// The pool must outlive any thread's use of its arenas. Arenas are not
+// returned to the pool; they are freed when the pool is destroyed.
+class arena_pool {
+public:
+  explicit arena_pool(size_t capacity) : capacity_{capacity} {}
+  arena_pool(const arena_pool&) = delete;
+  arena_pool& operator=(const arena_pool&) = delete;
+
+  // The calling thread's own arena, created on first use.
+  extensible_arena& local() {
+    auto& slot = tls_slot();
+    if (!slot) {
+      lock l{sync_};
+      slot = &arenas_.emplace_back(capacity_);
+    }
+    return *slot;
+  }
+
+  // Number of arenas handed out so far.
+  [[nodiscard]] size_t size() const {
+    lock l{sync_};
+    return arenas_.size();
+  }
+
+  // Sets thread-local scope to the calling thread's pool arena.
+  class scope {
+  public:
+    explicit scope(arena_pool& pool) : inner_{pool.local()} {}
+
+  private:
+    extensible_arena::scope inner_;
+  };
+
+private:
+  // The calling thread's slot for this pool. Keyed on `id_` rather than the
+  // object address: address-keyed entries outlive the pool, so a new pool
+  // constructed where a destroyed one used to live would hand threads that
+  // touched the old one a dangling arena pointer. Ids are never reused, so
+  // a stale entry costs a few bytes per thread instead of a use-after-free.
+  extensible_arena*& tls_slot() {
+    thread_local std::unordered_map<size_t, extensible_arena*> slots;
+    return slots[id_];
+  }
+
+  // Mint a process-unique pool id.
+  static size_t next_id() noexcept {
+    static std::atomic<size_t> counter{};
+    return counter.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  const size_t id_ = next_id();
+  const size_t capacity_;
+  synchronizer sync_;
+
+  // Deque for stable addresses.
+  std::deque<extensible_arena> arenas_;
+};
+
+// Typed slab pool with stable pointers and an intrusive free list.
+//
+// Companion to `extensible_arena` for fixed-size, high-churn objects, such
+// as connections: backing storage is an arena, so blocks chain and grow the
+// same way, but destroyed objects return their slot to a free list for
+// recycling instead of being lost until a reset. Steady-state churn
+// therefore never touches the global allocator, and pointers are stable
+// because blocks are never moved or freed before the pool is.
+//
+// Not thread-safe; see `slab_pool_per_thread` for churn from many threads.
+template<typename T>
+class slab_pool {
+public:
+  explicit slab_pool(size_t slots_per_block) noexcept
+      : arena_{slots_per_block * sizeof(slot)} {}
+  slab_pool(const slab_pool&) = delete;
+  slab_pool& operator=(const slab_pool&) = delete;
+
+  // Construct a `T` in a recycled or freshly carved slot.
+  template<class... Args>
+  [[nodiscard]] T* create(Args&&... args) {
+    return new (acquire()) T(std::forward<Args>(args)...);
+  }
+
+  // Destruct a pool object and recycle its slot.
+  void destroy(T* p) noexcept {
+    p->~T();
+    release(p);
+  }
+
+  // Recycle or carve a raw slot, without constructing.
+  [[nodiscard]] void* acquire() {
+    if (auto* s = free_list_) {
+      free_list_ = s->next_free;
+      --free_count_;
+      return s;
+    }
+    ++slot_count_;
+    extensible_arena::scope scope{arena_};
+    return extensible_arena::allocate(sizeof(slot), alignof(slot));
+  }
+
+  // Return a raw slot to the free list. It must have come from this pool.
+  void release(void* p) noexcept {
+    auto* s = static_cast<slot*>(p);
+    s->next_free = free_list_;
+    free_list_ = s;
+    ++free_count_;
+  }
+
+  // Count of live objects.
+  [[nodiscard]] size_t size() const noexcept {
+    return slot_count_ - free_count_;
+  }
+
+  // Count of recycled slots ready for reuse.
+  [[nodiscard]] size_t available() const noexcept { return free_count_; }
+
+private:
+  union slot {
+    slot* next_free;
+    alignas(T) std::byte storage[sizeof(T)];
+  };
+
+  extensible_arena arena_;
+  slot* free_list_{};
+  size_t slot_count_{};
+  size_t free_count_{};
+};
+
+// Pool of slab pools with per-thread binding, mirroring `arena_pool`: each
+// thread is lazily handed its own `slab_pool`, so churn is contention-free
+// after the first touch. Create and destroy on the same thread; all blocks
+// are owned here, so every pointer remains valid until this is destroyed.
+template<typename T>
+class slab_pool_per_thread {
+public:
+  explicit slab_pool_per_thread(size_t slots_per_block)
+      : slots_per_block_{slots_per_block} {}
+  slab_pool_per_thread(const slab_pool_per_thread&) = delete;
+  slab_pool_per_thread& operator=(const slab_pool_per_thread&) = delete;
+
+  // The calling thread's own pool, created on first use.
+  slab_pool<T>& local() {
+    auto& slot = tls_slot();
+    if (!slot) {
+      lock l{sync_};
+      slot = &pools_.emplace_back(slots_per_block_);
+    }
+    return *slot;
+  }
+
+  template<class... Args>
+  [[nodiscard]] T* create(Args&&... args) {
+    return local().create(std::forward<Args>(args)...);
+  }
+
+  void destroy(T* p) noexcept { local().destroy(p); }
+
+  // Number of pools handed out so far.
+  [[nodiscard]] size_t size() const {
+    lock l{sync_};
+    return pools_.size();
+  }
+
+private:
+  // The calling thread's slot for this pool set. Keyed on a minted id, not
+  // the object address, for the same reason as `arena_pool`: an address can
+  // be recycled by a later instance, but an id can't.
+  slab_pool<T>*& tls_slot() {
+    thread_local std::unordered_map<size_t, slab_pool<T>*> slots;
+    return slots[id_];
+  }
+
+  // Mint a process-unique pool-set id.
+  static size_t next_id() noexcept {
+    static std::atomic<size_t> counter{};
+    return counter.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  const size_t id_ = next_id();
+  const size_t slots_per_block_;
+  synchronizer sync_;
+
+  // Deque for stable addresses.
+  std::deque<slab_pool<T>> pools_;
 };
 
 // Allocator that uses the `extensible_arena` that is currently in scope.
@@ -176,6 +606,12 @@ public:
   }
 
   constexpr void deallocate(T*, std::size_t) {}
+
+  // All instances are interchangeable: they defer to the scoped arena.
+  template<typename U>
+  constexpr bool operator==(const arena_allocator<U>&) const noexcept {
+    return true;
+  }
 };
 
 // Arena-specialized collections. Can be reinterpreted as their standard forms
@@ -16,7 +16,10 @@
 // limitations under the License.
 #pragma once
 #include <array>
+#include <atomic>
+#include <bit>
 #include <span>
+#include <utility>
 #include <vector>
 
 namespace corvid { inline namespace adapters {
@@ -27,7 +30,11 @@ namespace corvid { inline namespace adapters {
 //
 // As an optimization, you may specialize on a SZ smaller than size_t, such as
 // uint32_t, if you know that your buffer will never be larger than that.
-template<typename T, typename SZ = size_t>
+//
+// As a further optimization, you may set POW2 if the capacity is always a
+// power of two, which replaces the modulo in index wrapping with a bitmask.
+// This is asserted at construction. See `pow2_circular_buffer`.
+template<typename T, typename SZ = size_t, bool POW2 = false>
 class circular_buffer {
 public:
   using value_type = T;
@@ -56,6 +63,7 @@ public:
   requires std::convertible_to<U, std::span<T>>
       : range_(std::forward<U>(u)), back_(last_index()) {
     assert(range_.size() <= std::numeric_limits<size_type>::max());
+    if constexpr (POW2) assert(std::has_single_bit(range_.size()));
   }
 
   // Construct with an initial size, from container.
@@ -65,6 +73,7 @@ public:
         size_(size) {
     assert(range_.size() <= std::numeric_limits<size_type>::max());
     assert(size <= capacity());
+    if constexpr (POW2) assert(std::has_single_bit(range_.size()));
   }
 
   // Clear the buffer. Does not affect underlying container.
@@ -155,6 +164,59 @@ public:
     return &(add_back() = value_type{std::forward<Args>(args)...});
   }
 
+  // Push as many values as fit onto the back, in order, returning how many
+  // were pushed. Never overwrites. The storage is contiguous in at most two
+  // segments, so this is at most two `std::copy_n` calls, which lower to
+  // memcpy for trivially copyable types.
+  size_type push_back_bulk(std::span<const T> values) noexcept(
+      noexcept(*range_.begin() = values[0])) {
+    const auto count = static_cast<size_type>(
+        std::min<size_t>(values.size(), capacity() - size_));
+    if (!count) return 0;
+    auto* base = &*range_.begin();
+    const auto write = back_ == last_index() ? size_type{} : back_ + 1;
+    const auto first = std::min<size_type>(count, capacity() - write);
+    std::copy_n(values.data(), first, base + write);
+    std::copy_n(values.data() + first, count - first, base);
+    back_ = wrap(write + count - 1);
+    size_ += count;
+    return count;
+  }
+
+  // Pop up to `out.size()` values from the front, in order, returning how
+  // many were popped. At most two `std::copy_n` calls.
+  size_type pop_front_bulk(std::span<T> out) noexcept(
+      noexcept(out[0] = *range_.begin())) {
+    const auto count =
+        static_cast<size_type>(std::min<size_t>(out.size(), size_));
+    if (!count) return 0;
+    const auto* base = &*range_.begin();
+    const auto first = std::min<size_type>(count, capacity() - front_);
+    std::copy_n(base + front_, first, out.data());
+    std::copy_n(base, count - first, out.data() + first);
+    return pop_front_bulk(count);
+  }
+
+  // Drop up to `count` values from the front without copying, returning how
+  // many were dropped. Pair with `peek_spans` for zero-copy draining.
+  size_type pop_front_bulk(size_type count) noexcept {
+    count = std::min(count, size_);
+    front_ = wrap(front_ + count);
+    size_ -= count;
+    return count;
+  }
+
+  // The readable contents, as up to two contiguous spans in front-to-back
+  // order; the second is empty unless the data wraps. Consume with
+  // `pop_front_bulk`.
+  [[nodiscard]] std::array<std::span<const T>, 2> peek_spans() const noexcept {
+    if (!size_) return {};
+    const auto* base = &*range_.begin();
+    const auto first = std::min<size_type>(size_, capacity() - front_);
+    return {std::span<const T>{base + front_, first},
+        std::span<const T>{base, size_type(size_ - first)}};
+  }
+
   // Remove front or back element, returning a reference to it. Must not be
   // empty.
   auto& pop_front() noexcept {
@@ -292,14 +354,22 @@ private:
 
   size_type last_index() const noexcept { return capacity() - 1; }
 
+  // Wrap an index into the capacity, with a bitmask when POW2.
+  size_type wrap(size_type index) const noexcept {
+    if constexpr (POW2)
+      return index & last_index();
+    else
+      return index % capacity();
+  }
+
   // Note: Size must be adjusted before calling these, due to offset modulo.
   size_type index_at(size_type offset) const noexcept {
     offset %= size();
-    return (front_ + offset) % capacity();
+    return wrap(front_ + offset);
   }
   size_type index_at_checked(size_type offset) const {
     if (offset >= size_) throw std::out_of_range("index out of range");
-    return (front_ + offset) % capacity();
+    return wrap(front_ + offset);
   }
 
   // Note: Size must be adjusted before calling these, due to data().
@@ -341,6 +411,255 @@ private:
   }
 };
 
+// Single-producer/single-consumer circular buffer over any container that
+// supports `std::span`. Does not own the underlying container.
+//
+// One thread may call the push side and one thread the pop side, with no
+// other synchronization: the head and tail indexes are atomics on separate
+// cache lines, and each handoff costs one acquire load and one release store
+// per side. There is no overwrite-on-full mode, no random access, and no
+// iteration, since none of those can be made coherent across threads; use
+// `circular_buffer` under a lock if you need them.
+//
+// One slot is sacrificed to distinguish full from empty, so the usable
+// capacity is one less than the span's size.
+//
+// As with `circular_buffer`, setting POW2 promises that the span's size is a
+// power of two, replacing the wrap branch with a bitmask.
+template<typename T, typename SZ = size_t, bool POW2 = false>
+class spsc_circular_buffer {
+public:
+  using value_type = T;
+  using size_type = SZ;
+  static_assert(std::is_unsigned_v<size_type>);
+
+  // Construct from any container that converts to std::span. Starts off
+  // empty. Not movable, because the producer and consumer each hold a
+  // reference to it.
+  template<typename U>
+  explicit spsc_circular_buffer(U&& u) noexcept
+  requires std::convertible_to<U, std::span<T>>
+      : range_(std::forward<U>(u)) {
+    assert(range_.size() > 1);
+    assert(range_.size() <= std::numeric_limits<size_type>::max());
+    if constexpr (POW2) assert(std::has_single_bit(range_.size()));
+  }
+
+  spsc_circular_buffer(const spsc_circular_buffer&) = delete;
+  spsc_circular_buffer& operator=(const spsc_circular_buffer&) = delete;
+
+  // Try to push a value. Returns whether there was room. Producer side only.
+  bool try_push(const value_type& value) noexcept(
+      noexcept(range_[0] = value)) {
+    const auto tail = tail_.load(std::memory_order_relaxed);
+    const auto next = next_index(tail);
+    if (next == head_.load(std::memory_order_acquire)) return false;
+    range_[tail] = value;
+    tail_.store(next, std::memory_order_release);
+    return true;
+  }
+  bool try_push(value_type&& value) noexcept(
+      noexcept(range_[0] = std::move(value))) {
+    const auto tail = tail_.load(std::memory_order_relaxed);
+    const auto next = next_index(tail);
+    if (next == head_.load(std::memory_order_acquire)) return false;
+    range_[tail] = std::move(value);
+    tail_.store(next, std::memory_order_release);
+    return true;
+  }
+  template<class... Args>
+  bool try_emplace(Args&&... args) noexcept(
+      noexcept(range_[0] = value_type{std::forward<Args>(args)...})) {
+    return try_push(value_type{std::forward<Args>(args)...});
+  }
+
+  // Try to pop a value into `value`. Returns whether there was one. Consumer
+  // side only.
+  bool try_pop(value_type& value) noexcept(
+      noexcept(value = std::move(range_[0]))) {
+    const auto head = head_.load(std::memory_order_relaxed);
+    if (head == tail_.load(std::memory_order_acquire)) return false;
+    value = std::move(range_[head]);
+    head_.store(next_index(head), std::memory_order_release);
+    return true;
+  }
+
+  // Size accessors. These are snapshots: each is exact only on the thread
+  // that moves the index it depends on, so the producer can trust `full` and
+  // the consumer can trust `empty`.
+  [[nodiscard]] size_type capacity() const noexcept {
+    return range_.size() - 1;
+  }
+  [[nodiscard]] size_type size() const noexcept {
+    const auto head = head_.load(std::memory_order_acquire);
+    const auto tail = tail_.load(std::memory_order_acquire);
+    return tail >= head ? tail - head : tail + range_.size() - head;
+  }
+  [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+  [[nodiscard]] bool full() const noexcept { return size() == capacity(); }
+
+private:
+  static constexpr size_t cache_line_size = 64;
+
+  std::span<T> range_;
+
+  // Consumer and producer indexes, padded apart so that neither side's
+  // stores bounce the other's cache line.
+  alignas(cache_line_size) std::atomic<size_type> head_{};
+  alignas(cache_line_size) std::atomic<size_type> tail_{};
+
+  size_type next_index(size_type index) const noexcept {
+    if constexpr (POW2)
+      return (index + 1) & static_cast<size_type>(range_.size() - 1);
+    else
+      return ++index == range_.size() ? size_type{} : index;
+  }
+};
+
+// Multi-producer/single-consumer circular buffer over a span of slots. Does
+// not own the underlying container.
+//
+// Any number of threads may push and one thread pops, with no other
+// synchronization. Each slot carries a sequence number, per Vyukov's bounded
+// queue: a producer claims a slot with one compare-exchange on the tail and
+// publishes it by bumping the slot's sequence, so producers never wait on
+// each other's writes and the consumer sees slots strictly in claim order.
+// A full buffer fails the push rather than blocking.
+//
+// Unlike the other adapters, the element is wrapped in a `slot` holding the
+// sequence alongside the value, so the caller provides a container of
+// `mpsc_circular_buffer<T>::slot`. The capacity must be a power of two, and
+// all of it is usable; the sequences distinguish full from empty.
+template<typename T, typename SZ = size_t>
+class mpsc_circular_buffer {
+public:
+  using value_type = T;
+  using size_type = SZ;
+  static_assert(std::is_unsigned_v<size_type>);
+
+  struct slot {
+    std::atomic<size_type> sequence{};
+    T value{};
+  };
+
+  // Construct from any container that converts to a span of slots. Starts
+  // off empty. Not movable, because producers and the consumer each hold a
+  // reference to it.
+  template<typename U>
+  explicit mpsc_circular_buffer(U&& u) noexcept
+  requires std::convertible_to<U, std::span<slot>>
+      : range_(std::forward<U>(u)) {
+    assert(range_.size() > 1);
+    assert(range_.size() <= (std::numeric_limits<size_type>::max() >> 1));
+    assert(std::has_single_bit(range_.size()));
+    for (size_type ndx = 0; ndx < range_.size(); ++ndx)
+      range_[ndx].sequence.store(ndx, std::memory_order_relaxed);
+  }
+
+  mpsc_circular_buffer(const mpsc_circular_buffer&) = delete;
+  mpsc_circular_buffer& operator=(const mpsc_circular_buffer&) = delete;
+
+  // Try to push a value. Returns whether there was room. Any thread.
+  bool try_push(const value_type& value) {
+    if (auto* s = claim()) {
+      s->value = value;
+      publish(*s);
+      return true;
+    }
+    return false;
+  }
+  bool try_push(value_type&& value) {
+    if (auto* s = claim()) {
+      s->value = std::move(value);
+      publish(*s);
+      return true;
+    }
+    return false;
+  }
+  template<class... Args>
+  bool try_emplace(Args&&... args) {
+    return try_push(value_type{std::forward<Args>(args)...});
+  }
+
+  // Try to pop a value into `value`. Returns whether there was one. Consumer
+  // side only.
+  bool try_pop(value_type& value) {
+    const auto pos = head_.load(std::memory_order_relaxed);
+    auto& s = range_[pos & mask()];
+    const auto seq = s.sequence.load(std::memory_order_acquire);
+    if (seq != static_cast<size_type>(pos + 1)) return false;
+    value = std::move(s.value);
+    s.sequence.store(static_cast<size_type>(pos + range_.size()),
+        std::memory_order_release);
+    head_.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Size accessors. These are snapshots: only the consumer can trust
+  // `empty`, and any producer may find a `full` buffer already drained.
+  [[nodiscard]] size_type capacity() const noexcept { return range_.size(); }
+  [[nodiscard]] size_type size() const noexcept {
+    const auto head = head_.load(std::memory_order_acquire);
+    const auto tail = tail_.load(std::memory_order_acquire);
+    return tail - head;
+  }
+  [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+  [[nodiscard]] bool full() const noexcept { return size() == capacity(); }
+
+private:
+  static constexpr size_t cache_line_size = 64;
+  using signed_size = std::make_signed_t<size_type>;
+
+  std::span<slot> range_;
+
+  // Consumer and producer indexes, padded apart so that neither side's
+  // stores bounce the other's cache line. These increase without wrapping;
+  // the mask is applied on access, which stays consistent across unsigned
+  // overflow because the capacity is a power of two.
+  alignas(cache_line_size) std::atomic<size_type> head_{};
+  alignas(cache_line_size) std::atomic<size_type> tail_{};
+
+  size_type mask() const noexcept {
+    return static_cast<size_type>(range_.size() - 1);
+  }
+
+  // Claim the slot at the tail, or return nullptr when full. A slot whose
+  // sequence has not caught up to the tail is still being drained by the
+  // consumer; one that is past it was claimed by another producer first.
+  slot* claim() noexcept {
+    auto pos = tail_.load(std::memory_order_relaxed);
+    for (;;) {
+      auto& s = range_[pos & mask()];
+      const auto seq = s.sequence.load(std::memory_order_acquire);
+      const auto dif = static_cast<signed_size>(seq - pos);
+      if (dif == 0) {
+        if (tail_.compare_exchange_weak(pos, pos + 1,
+                std::memory_order_relaxed))
+          return &s;
+      } else if (dif < 0) {
+        return nullptr;
+      } else {
+        pos = tail_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  // Make a claimed slot's value visible to the consumer.
+  void publish(slot& s) noexcept {
+    s.sequence.store(s.sequence.load(std::memory_order_relaxed) + 1,
+        std::memory_order_release);
+  }
+};
+
+// Power-of-two aliases. The capacity must be a power of two, which is
+// asserted at construction; in exchange, index wrapping is a bitmask
+// instead of a modulo.
+template<typename T, typename SZ = size_t>
+using pow2_circular_buffer = circular_buffer<T, SZ, true>;
+
+template<typename T, typename SZ = size_t>
+using pow2_spsc_circular_buffer = spsc_circular_buffer<T, SZ, true>;
+
 // Deduction guides.
 template<typename T>
 circular_buffer(std::span<T>&) -> circular_buffer<T>;
@@ -359,4 +678,13 @@ circular_buffer(std::array<T, N>&) -> circular_buffer<T>;
 
 template<typename T, std::size_t N, typename SZ>
 circular_buffer(std::array<T, N>&, SZ) -> circular_buffer<T>;
+
+template<typename T>
+spsc_circular_buffer(std::span<T>&) -> spsc_circular_buffer<T>;
+
+template<typename T>
+spsc_circular_buffer(std::vector<T>&) -> spsc_circular_buffer<T>;
+
+template<typename T, std::size_t N>
+spsc_circular_buffer(std::array<T, N>&) -> spsc_circular_buffer<T>;
 }} // namespace corvid::adapters
@@ -0,0 +1,139 @@
+// Corvid20: A general-purpose C++20 library extending std.
+// https://github.com/stevensudit/Corvid20
+//
+// Copyright 2022-2024 Steven Sudit
+//
+// Licensed under the Apache License, Version 2.0(the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#pragma once
+#include "containers_shared.h"
+#include "interval.h"
+#include "../enums/sequence_enum.h"
+#include <array>
+#include <cassert>
+
+namespace corvid { inline namespace enum_maps {
+
+//
+// enum_map
+//
+
+// A map keyed by a sequence enum, backed by a `std::array` sized from the
+// enum's registered [seq_min_v, seq_max_v] range.
+//
+// Every key in the range is always present, with its value
+// default-constructed until assigned, so there is no insertion, hashing, or
+// pointer chasing: lookup is an index into contiguous storage. This is the
+// right replacement for a `std::map`/`std::unordered_map` whose keys are a
+// small, dense enum, such as per-state or per-event counters.
+//
+// The full range must be sensible to instantiate; a sparse or huge enum
+// belongs in an actual map.
+template<sequence::SequentialEnum E, typename V>
+class enum_map {
+public:
+  using key_type = E;
+  using mapped_type = V;
+  using value_type = V;
+  using size_type = size_t;
+  using storage_type = std::array<V, size_t{sequence::seq_size_v<E>}>;
+  using iterator = typename storage_type::iterator;
+  using const_iterator = typename storage_type::const_iterator;
+
+  constexpr enum_map() = default;
+  constexpr enum_map(const enum_map&) = default;
+  constexpr enum_map& operator=(const enum_map&) = default;
+
+  //
+  // Lookup
+  //
+
+  // Unchecked access, asserting that the key is in range.
+  [[nodiscard]] constexpr V& operator[](E key) noexcept {
+    assert(contains(key));
+    return values_[index(key)];
+  }
+  [[nodiscard]] constexpr const V& operator[](E key) const noexcept {
+    assert(contains(key));
+    return values_[index(key)];
+  }
+
+  // Checked access.
+  [[nodiscard]] constexpr V& at(E key) {
+    if (!contains(key)) throw std::out_of_range("key out of enum range");
+    return values_[index(key)];
+  }
+  [[nodiscard]] constexpr const V& at(E key) const {
+    if (!contains(key)) throw std::out_of_range("key out of enum range");
+    return values_[index(key)];
+  }
+
+  // Whether the key falls in the enum's registered range. All such keys are
+  // present, by construction.
+  [[nodiscard]] constexpr bool contains(E key) const noexcept {
+    const auto u = as_underlying(key);
+    return u >= sequence::seq_min_num_v<E> &&
+           u <= sequence::seq_max_num_v<E>;
+  }
+
+  //
+  // Size
+  //
+
+  [[nodiscard]] constexpr size_type size() const noexcept {
+    return values_.size();
+  }
+  [[nodiscard]] constexpr bool empty() const noexcept {
+    return values_.empty();
+  }
+
+  //
+  // Iteration
+  //
+
+  // Iterates over values; pair with `keys` to recover the key for an index.
+  [[nodiscard]] constexpr iterator begin() noexcept { return values_.begin(); }
+  [[nodiscard]] constexpr iterator end() noexcept { return values_.end(); }
+  [[nodiscard]] constexpr const_iterator begin() const noexcept {
+    return values_.begin();
+  }
+  [[nodiscard]] constexpr const_iterator end() const noexcept {
+    return values_.end();
+  }
+
+  // The keys, as an iterable interval.
+  [[nodiscard]] static constexpr auto keys() noexcept {
+    return interval<E>{sequence::seq_min_v<E>, sequence::seq_max_v<E>};
+  }
+
+  //
+  // Modification
+  //
+
+  constexpr void fill(const V& value) { values_.fill(value); }
+  constexpr void clear() { values_ = storage_type{}; }
+
+  [[nodiscard]] constexpr V* data() noexcept { return values_.data(); }
+  [[nodiscard]] constexpr const V* data() const noexcept {
+    return values_.data();
+  }
+
+private:
+  [[nodiscard]] static constexpr size_t index(E key) noexcept {
+    return static_cast<size_t>(
+        as_underlying(key) - sequence::seq_min_num_v<E>);
+  }
+
+  storage_type values_{};
+};
+
+}} // namespace corvid::enum_maps
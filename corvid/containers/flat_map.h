@@ -0,0 +1,254 @@
+// Corvid20: A general-purpose C++20 library extending std.
+// https://github.com/stevensudit/Corvid20
+//
+// Copyright 2022-2024 Steven Sudit
+//
+// Licensed under the Apache License, Version 2.0(the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include "containers_shared.h"
+#include "transparent.h"
+
+namespace corvid { inline namespace containers {
+
+// Flat sorted companions to `std::map`/`std::set`.
+//
+// The elements live sorted in one contiguous `std::vector`, so a lookup is a
+// cache-friendly binary search and iteration is a linear walk, which beats a
+// node-based tree for the small (tens to low hundreds of entries) lookup
+// tables that get built once and probed constantly. Inserts and erases shift
+// the tail, so bulk-build then probe is the intended usage.
+//
+// The comparator is transparent by default, so heterogeneous lookups need no
+// temporary keys; `find` pairs with `find_opt` from `opt_find.h`. See
+// `string_flat_map`/`string_flat_set` for the stringlike-keyed versions.
+
+// Flat sorted map over contiguous storage.
+template<typename K, typename V, typename CMP = std::less<>>
+class flat_map {
+public:
+  using key_type = K;
+  using mapped_type = V;
+  using value_type = std::pair<K, V>;
+  using key_compare = CMP;
+  using storage_type = std::vector<value_type>;
+  using iterator = typename storage_type::iterator;
+  using const_iterator = typename storage_type::const_iterator;
+  using size_type = typename storage_type::size_type;
+
+  constexpr flat_map() = default;
+  constexpr explicit flat_map(key_compare cmp) : cmp_{std::move(cmp)} {}
+  constexpr flat_map(std::initializer_list<value_type> values,
+      key_compare cmp = {})
+      : cmp_{std::move(cmp)} {
+    reserve(values.size());
+    for (auto& value : values) insert(value);
+  }
+
+  // Iteration, in key order.
+  [[nodiscard]] constexpr iterator begin() noexcept { return data_.begin(); }
+  [[nodiscard]] constexpr iterator end() noexcept { return data_.end(); }
+  [[nodiscard]] constexpr const_iterator begin() const noexcept {
+    return data_.begin();
+  }
+  [[nodiscard]] constexpr const_iterator end() const noexcept {
+    return data_.end();
+  }
+
+  [[nodiscard]] constexpr size_type size() const noexcept {
+    return data_.size();
+  }
+  [[nodiscard]] constexpr bool empty() const noexcept { return data_.empty(); }
+  constexpr void clear() noexcept { data_.clear(); }
+  constexpr void reserve(size_type n) { data_.reserve(n); }
+
+  // First element not less than `key`.
+  template<typename U>
+  [[nodiscard]] constexpr const_iterator lower_bound(const U& key) const {
+    return std::lower_bound(data_.begin(), data_.end(), key,
+        [this](const value_type& e, const U& k) { return cmp_(e.first, k); });
+  }
+  template<typename U>
+  [[nodiscard]] constexpr iterator lower_bound(const U& key) {
+    return std::lower_bound(data_.begin(), data_.end(), key,
+        [this](const value_type& e, const U& k) { return cmp_(e.first, k); });
+  }
+
+  // Find by (transparent) key. See also `find_opt`.
+  template<typename U>
+  [[nodiscard]] constexpr const_iterator find(const U& key) const {
+    const auto it = lower_bound(key);
+    return it != data_.end() && !cmp_(key, it->first) ? it : data_.end();
+  }
+  template<typename U>
+  [[nodiscard]] constexpr iterator find(const U& key) {
+    const auto it = lower_bound(key);
+    return it != data_.end() && !cmp_(key, it->first) ? it : data_.end();
+  }
+
+  template<typename U>
+  [[nodiscard]] constexpr bool contains(const U& key) const {
+    return find(key) != data_.end();
+  }
+
+  // Insert, keeping sort order. Returns the element and whether it was
+  // added; an existing element is left unchanged.
+  constexpr std::pair<iterator, bool> insert(const value_type& value) {
+    return emplace_at(lower_bound(value.first), value.first, value);
+  }
+  constexpr std::pair<iterator, bool> insert(value_type&& value) {
+    const auto it = lower_bound(value.first);
+    return emplace_at(it, value.first, std::move(value));
+  }
+
+  // As `insert`, but constructs the mapped value in place from `args` only
+  // when the key is absent.
+  template<typename U, typename... Args>
+  constexpr std::pair<iterator, bool> try_emplace(U&& key, Args&&... args) {
+    const auto it = lower_bound(key);
+    if (it != data_.end() && !cmp_(key, it->first)) return {it, false};
+    return {data_.emplace(it, key_type{std::forward<U>(key)},
+                mapped_type{std::forward<Args>(args)...}),
+        true};
+  }
+
+  // Mapped value for `key`, default-constructed on first use.
+  template<typename U>
+  [[nodiscard]] constexpr mapped_type& operator[](U&& key) {
+    return try_emplace(std::forward<U>(key)).first->second;
+  }
+
+  // Remove by (transparent) key, returning how many were removed.
+  template<typename U>
+  constexpr size_type erase(const U& key) {
+    const auto it = find(key);
+    if (it == data_.end()) return 0;
+    data_.erase(it);
+    return 1;
+  }
+
+  constexpr bool operator==(const flat_map& rhs) const {
+    return data_ == rhs.data_;
+  }
+
+private:
+  template<typename U, typename T>
+  constexpr std::pair<iterator, bool> emplace_at(iterator it, const U& key,
+      T&& value) {
+    if (it != data_.end() && !cmp_(key, it->first)) return {it, false};
+    return {data_.insert(it, std::forward<T>(value)), true};
+  }
+
+  storage_type data_;
+  [[no_unique_address]] key_compare cmp_;
+};
+
+// Flat sorted set over contiguous storage.
+template<typename K, typename CMP = std::less<>>
+class flat_set {
+public:
+  using key_type = K;
+  using value_type = K;
+  using key_compare = CMP;
+  using storage_type = std::vector<value_type>;
+  using iterator = typename storage_type::const_iterator;
+  using const_iterator = typename storage_type::const_iterator;
+  using size_type = typename storage_type::size_type;
+
+  constexpr flat_set() = default;
+  constexpr explicit flat_set(key_compare cmp) : cmp_{std::move(cmp)} {}
+  constexpr flat_set(std::initializer_list<value_type> values,
+      key_compare cmp = {})
+      : cmp_{std::move(cmp)} {
+    reserve(values.size());
+    for (auto& value : values) insert(value);
+  }
+
+  // Iteration, in key order. Always const: elements can't be mutated in
+  // place without breaking the sort.
+  [[nodiscard]] constexpr const_iterator begin() const noexcept {
+    return data_.begin();
+  }
+  [[nodiscard]] constexpr const_iterator end() const noexcept {
+    return data_.end();
+  }
+
+  [[nodiscard]] constexpr size_type size() const noexcept {
+    return data_.size();
+  }
+  [[nodiscard]] constexpr bool empty() const noexcept { return data_.empty(); }
+  constexpr void clear() noexcept { data_.clear(); }
+  constexpr void reserve(size_type n) { data_.reserve(n); }
+
+  // First element not less than `key`.
+  template<typename U>
+  [[nodiscard]] constexpr const_iterator lower_bound(const U& key) const {
+    return std::lower_bound(data_.begin(), data_.end(), key,
+        [this](const value_type& e, const U& k) { return cmp_(e, k); });
+  }
+
+  // Find by (transparent) key. See also `find_opt`.
+  template<typename U>
+  [[nodiscard]] constexpr const_iterator find(const U& key) const {
+    const auto it = lower_bound(key);
+    return it != data_.end() && !cmp_(key, *it) ? it : data_.end();
+  }
+
+  template<typename U>
+  [[nodiscard]] constexpr bool contains(const U& key) const {
+    return find(key) != data_.end();
+  }
+
+  // Insert, keeping sort order. Returns the element and whether it was
+  // added.
+  constexpr std::pair<const_iterator, bool> insert(const value_type& value) {
+    return insert_at(lower_bound(value), value);
+  }
+  constexpr std::pair<const_iterator, bool> insert(value_type&& value) {
+    const auto it = lower_bound(value);
+    return insert_at(it, std::move(value));
+  }
+
+  // Remove by (transparent) key, returning how many were removed.
+  template<typename U>
+  constexpr size_type erase(const U& key) {
+    const auto it = find(key);
+    if (it == data_.end()) return 0;
+    data_.erase(it);
+    return 1;
+  }
+
+  constexpr bool operator==(const flat_set& rhs) const {
+    return data_ == rhs.data_;
+  }
+
+private:
+  template<typename T>
+  constexpr std::pair<const_iterator, bool>
+  insert_at(const_iterator it, T&& value) {
+    if (it != data_.end() && !cmp_(value, *it)) return {it, false};
+    return {data_.insert(it, std::forward<T>(value)), true};
+  }
+
+  storage_type data_;
+  [[no_unique_address]] key_compare cmp_;
+};
+
+// Flat map keyed by `std::string`, with transparent search.
+template<typename V = std::string>
+using string_flat_map = flat_map<std::string, V, transparent_less_stringlike>;
+
+// Flat set of `std::string`, with transparent search.
+using string_flat_set = flat_set<std::string, transparent_less_stringlike>;
+
+}} // namespace corvid::containers
@@ -0,0 +1,180 @@
+// Corvid20: A general-purpose C++20 library extending std.
+// https://github.com/stevensudit/Corvid20
+//
+// Copyright 2022-2024 Steven Sudit
+//
+// Licensed under the Apache License, Version 2.0(the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "containers_shared.h"
+#include "custom_handle.h"
+#include "own_ptr.h"
+#include "sync_lock.h"
+
+namespace corvid { inline namespace handlepool {
+
+// Recycling pool for `custom_handle`-managed resources.
+//
+// RAII over OS handles through `own_ptr` is safe but closes the resource on
+// every release, so churn (per-request temp buffers, event fds) pays a
+// syscall pair per use. This pool layers recycling on top of an existing
+// custom deleter: released handles land on a bounded free list and are
+// handed back on the next acquisition, and the real deleter only runs when
+// the list overflows or the pool shuts down. Steady-state churn is then a
+// pointer swap instead of a close-and-reopen.
+//
+// The `Deleter` is any deleter in the `custom_handle` style, exposing the
+// handle as `pointer` and closing it in `operator()`. Acquired handles come
+// back as a `pooled_ptr`, an `own_ptr` whose deleter returns the handle
+// here instead of closing it, so the pool must outlive every outstanding
+// `pooled_ptr`.
+//
+// Note that a recycled handle retains whatever state the previous user left
+// it in; pool only resources that are safe to reuse as-is, or scrub them in
+// the factory on the way out.
+//
+// Not thread-safe; see `handle_pool_per_thread` for churn from many
+// threads.
+template<typename Deleter>
+class handle_pool {
+public:
+  using deleter_type = Deleter;
+  using handle_type = typename Deleter::pointer;
+  using element_type = typename handle_type::element_type;
+
+  // A deleter that hands the handle back to its pool instead of closing
+  // it, falling back to a real close when orphaned from a pool.
+  struct recycler {
+    using pointer = handle_type;
+    handle_pool* pool{};
+    void operator()(pointer p) const {
+      if (pool)
+        pool->recycle(p);
+      else
+        deleter_type{}(p);
+    }
+  };
+
+  // Owning pointer whose destructor recycles instead of closing.
+  using pooled_ptr = own_ptr<element_type, recycler>;
+
+  explicit handle_pool(size_t max_free = 16) : max_free_{max_free} {
+    free_.reserve(max_free_);
+  }
+  handle_pool(const handle_pool&) = delete;
+  handle_pool& operator=(const handle_pool&) = delete;
+  ~handle_pool() { clear(); }
+
+  // Hand out a recycled handle, or invoke `make` for a fresh one. The
+  // factory returns whatever the handle constructs from, such as the fd
+  // from an `open` call.
+  template<typename FACTORY>
+  [[nodiscard]] pooled_ptr acquire(FACTORY&& make) {
+    if (!free_.empty()) {
+      auto h = free_.back();
+      free_.pop_back();
+      return pooled_ptr{std::move(h), recycler{this}};
+    }
+    return pooled_ptr{handle_type{make()}, recycler{this}};
+  }
+
+  // Keep a released handle for reuse, or close it when the free list is
+  // full. Null handles are dropped, as a deleter would.
+  void recycle(handle_type h) {
+    if (!h) return;
+    if (free_.size() < max_free_)
+      free_.push_back(h);
+    else
+      del_(std::move(h));
+  }
+
+  // Close all pooled handles now.
+  void clear() noexcept {
+    for (auto& h : free_) del_(std::move(h));
+    free_.clear();
+  }
+
+  // Count of recycled handles ready for reuse.
+  [[nodiscard]] size_t available() const noexcept { return free_.size(); }
+
+  // Most handles the free list will hold before closing for real.
+  [[nodiscard]] size_t max_free() const noexcept { return max_free_; }
+
+private:
+  const size_t max_free_;
+  NO_UNIQUE_ADDRESS deleter_type del_;
+  std::vector<handle_type> free_;
+};
+
+// Pool of handle pools with per-thread binding, mirroring
+// `slab_pool_per_thread`: each thread is lazily handed its own
+// `handle_pool`, so churn is contention-free after the first touch.
+// Acquire and release on the same thread; all free lists are owned here,
+// so shutdown closes whatever the threads left pooled.
+template<typename Deleter>
+class handle_pool_per_thread {
+public:
+  using pooled_ptr = typename handle_pool<Deleter>::pooled_ptr;
+
+  explicit handle_pool_per_thread(size_t max_free = 16)
+      : max_free_{max_free} {}
+  handle_pool_per_thread(const handle_pool_per_thread&) = delete;
+  handle_pool_per_thread& operator=(const handle_pool_per_thread&) = delete;
+
+  // The calling thread's own pool, created on first use.
+  handle_pool<Deleter>& local() {
+    auto& slot = tls_slot();
+    if (!slot) {
+      lock l{sync_};
+      slot = &pools_.emplace_back(max_free_);
+    }
+    return *slot;
+  }
+
+  template<typename FACTORY>
+  [[nodiscard]] pooled_ptr acquire(FACTORY&& make) {
+    return local().acquire(std::forward<FACTORY>(make));
+  }
+
+  // Number of pools handed out so far.
+  [[nodiscard]] size_t size() const {
+    lock l{sync_};
+    return pools_.size();
+  }
+
+private:
+  // The calling thread's slot for this pool set. Keyed on a minted id, not
+  // the object address, for the same reason as `arena_pool`: an address can
+  // be recycled by a later instance, but an id can't, so a stale entry is
+  // inert instead of a dangling pool pointer.
+  handle_pool<Deleter>*& tls_slot() {
+    thread_local std::unordered_map<size_t, handle_pool<Deleter>*> slots;
+    return slots[id_];
+  }
+
+  // Mint a process-unique pool-set id.
+  static size_t next_id() noexcept {
+    static std::atomic<size_t> counter{};
+    return counter.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  const size_t id_ = next_id();
+  const size_t max_free_;
+  synchronizer sync_;
+
+  // Deque for stable addresses.
+  std::deque<handle_pool<Deleter>> pools_;
+};
+
+}} // namespace corvid::handlepool
@@ -1,4 +1,6 @@
 #pragma once
+#include <cstdint>
+#include <string_view>
 #include <unordered_map>
 
 namespace corvid { inline namespace container { inline namespace indirect_key {
@@ -78,6 +80,109 @@ struct indirect_map_key {
   };
 };
 
+// As `indirect_hash_key`, but carries the key's hash inline, computed once
+// at construction. Probes and rehashes then resolve on the cached value
+// without following the reference, and equality checks on distinct keys
+// usually short-circuit on mismatched hashes; the indirection is only
+// followed when hashes tie.
+template<typename T, typename H = std::hash<T>, typename E = std::equal_to<T>>
+struct indirect_cached_hash_key {
+  const T& key;
+  std::size_t cached_hash;
+
+  indirect_cached_hash_key(const T& key) : key{key}, cached_hash{H{}(key)} {}
+
+  // We don't want to bind to a temporary.
+  indirect_cached_hash_key(const T&&) = delete;
+
+  [[nodiscard]] operator const T&() const noexcept { return key; }
+
+  struct hash_equal_to {
+    using is_transparent = void;
+
+    std::size_t
+    operator()(const indirect_cached_hash_key& ik) const noexcept {
+      return ik.cached_hash;
+    }
+    template<typename U>
+    size_t operator()(const U& u) const noexcept {
+      return H{}(u);
+    }
+
+    bool operator()(const indirect_cached_hash_key& l,
+        const indirect_cached_hash_key& r) const noexcept {
+      return l.cached_hash == r.cached_hash && E{}(l.key, r.key);
+    }
+    template<typename U>
+    bool operator()(const indirect_cached_hash_key& l,
+        const U& r) const noexcept {
+      return E{}(l.key, r);
+    }
+    template<typename U>
+    bool operator()(const U& l,
+        const indirect_cached_hash_key& r) const noexcept {
+      return E{}(l, r.key);
+    }
+  };
+};
+
+// As `indirect_map_key`, but for stringlike keys: carries the first 8 bytes
+// of the key inline, packed big-endian so that comparing the words matches
+// lexicographic order, as with B-tree key prefixes. Most comparisons in a
+// large tree then resolve on the inline word; the reference is only
+// followed when the prefixes tie.
+//
+// The comparator must agree with unsigned-byte lexicographic order over the
+// first 8 bytes, as the default does.
+template<typename T, class C = std::less<T>>
+struct indirect_prefix_map_key {
+  const T& key;
+  uint64_t prefix;
+
+  indirect_prefix_map_key(const T& key)
+      : key{key}, prefix{make_prefix(key)} {}
+
+  // We don't want to bind to a temporary.
+  indirect_prefix_map_key(const T&&) = delete;
+
+  [[nodiscard]] operator const T&() const noexcept { return key; }
+
+  // Pack up to the first 8 bytes, big-endian, padded with zeroes.
+  [[nodiscard]] static constexpr uint64_t
+  make_prefix(std::string_view sv) noexcept {
+    uint64_t p{};
+    const auto len = sv.size() < 8 ? sv.size() : size_t{8};
+    for (size_t ndx = 0; ndx < len; ++ndx)
+      p |= static_cast<uint64_t>(static_cast<unsigned char>(sv[ndx]))
+           << (56 - 8 * ndx);
+    return p;
+  }
+
+  struct compare {
+    using is_transparent = void;
+
+    bool operator()(const indirect_prefix_map_key& l,
+        const indirect_prefix_map_key& r) const noexcept {
+      if (l.prefix != r.prefix) return l.prefix < r.prefix;
+      return C{}(l.key, r.key);
+    }
+    template<typename U>
+    bool operator()(const indirect_prefix_map_key& l,
+        const U& r) const noexcept {
+      const auto rp = make_prefix(std::string_view{r});
+      if (l.prefix != rp) return l.prefix < rp;
+      return C{}(l.key, r);
+    }
+    template<typename U>
+    bool operator()(const U& l,
+        const indirect_prefix_map_key& r) const noexcept {
+      const auto lp = make_prefix(std::string_view{l});
+      if (lp != r.prefix) return lp < r.prefix;
+      return C{}(l, r.key);
+    }
+  };
+};
+
 }}} // namespace corvid::container::indirect_key
 
 template<typename T, typename H, typename E>
@@ -91,3 +196,15 @@ struct std::equal_to<corvid::indirect_hash_key<T, H, E>>
 template<typename T, typename C>
 struct std::less<corvid::indirect_map_key<T, C>>
     : corvid::indirect_map_key<T, C>::compare {};
+
+template<typename T, typename H, typename E>
+struct std::hash<corvid::indirect_cached_hash_key<T, H, E>>
+    : corvid::indirect_cached_hash_key<T, H, E>::hash_equal_to {};
+
+template<typename T, typename H, typename E>
+struct std::equal_to<corvid::indirect_cached_hash_key<T, H, E>>
+    : corvid::indirect_cached_hash_key<T, H, E>::hash_equal_to {};
+
+template<typename T, typename C>
+struct std::less<corvid::indirect_prefix_map_key<T, C>>
+    : corvid::indirect_prefix_map_key<T, C>::compare {};
@@ -0,0 +1,123 @@
+// Corvid20: A general-purpose C++20 library extending std.
+// https://github.com/stevensudit/Corvid20
+//
+// Copyright 2022-2024 Steven Sudit
+//
+// Licensed under the Apache License, Version 2.0(the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#pragma once
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+namespace corvid { inline namespace container { inline namespace inplacefn {
+
+template<typename Sig, size_t BYTES = 32>
+class inplace_function;
+
+// Move-only type-erased callable with inline storage.
+//
+// A drop-in replacement for `std::function` in hot paths: the target is
+// stored in place, so construction, move, and destruction never allocate.
+// In exchange, the target must fit in BYTES (with natural alignment) and be
+// nothrow-move-constructible, both enforced at compile time, and the
+// wrapper is move-only. Size it to your largest capture; the default of 32
+// bytes fits a lambda capturing four pointers.
+//
+// As with `std::function`, `operator()` is const but invokes the target as
+// non-const, and invoking an empty instance throws `std::bad_function_call`.
+template<typename R, typename... Args, size_t BYTES>
+class inplace_function<R(Args...), BYTES> {
+public:
+  using result_type = R;
+
+  // Empty.
+  inplace_function() noexcept = default;
+  inplace_function(std::nullptr_t) noexcept {}
+
+  // Construct from any suitable callable, storing it in place.
+  template<typename F>
+  requires(!std::is_same_v<std::remove_cvref_t<F>, inplace_function> &&
+              std::is_invocable_r_v<R, std::remove_cvref_t<F>&, Args...>)
+  inplace_function(F&& f) {
+    using target_t = std::remove_cvref_t<F>;
+    static_assert(sizeof(target_t) <= BYTES,
+        "callable does not fit; increase BYTES");
+    static_assert(alignof(target_t) <= alignof(std::max_align_t));
+    static_assert(std::is_nothrow_move_constructible_v<target_t>);
+    new (&storage_) target_t{std::forward<F>(f)};
+    vtbl_ = &vtable_for<target_t>;
+  }
+
+  // Move-only.
+  inplace_function(inplace_function&& other) noexcept : vtbl_{other.vtbl_} {
+    if (vtbl_) vtbl_->relocate(&other.storage_, &storage_);
+    other.vtbl_ = nullptr;
+  }
+  inplace_function& operator=(inplace_function&& other) noexcept {
+    if (this != &other) {
+      if (vtbl_) vtbl_->destroy(&storage_);
+      vtbl_ = std::exchange(other.vtbl_, nullptr);
+      if (vtbl_) vtbl_->relocate(&other.storage_, &storage_);
+    }
+    return *this;
+  }
+  inplace_function& operator=(std::nullptr_t) noexcept {
+    if (vtbl_) vtbl_->destroy(&storage_);
+    vtbl_ = nullptr;
+    return *this;
+  }
+
+  ~inplace_function() {
+    if (vtbl_) vtbl_->destroy(&storage_);
+  }
+
+  // Invoke. Must not be empty.
+  R operator()(Args... args) const {
+    if (!vtbl_) throw std::bad_function_call{};
+    return vtbl_->invoke(&storage_, std::forward<Args>(args)...);
+  }
+
+  [[nodiscard]] explicit operator bool() const noexcept { return vtbl_; }
+
+private:
+  struct vtable {
+    R (*invoke)(const void*, Args&&...);
+    void (*relocate)(void*, void*) noexcept;
+    void (*destroy)(void*) noexcept;
+  };
+
+  template<typename target_t>
+  static constexpr vtable vtable_for{
+      [](const void* storage, Args&&... args) -> R {
+        // Const here mirrors `std::function`: the wrapper is const, the
+        // target is invoked as non-const.
+        return std::invoke(
+            *static_cast<target_t*>(const_cast<void*>(storage)),
+            std::forward<Args>(args)...);
+      },
+      [](void* from, void* to) noexcept {
+        auto& target = *static_cast<target_t*>(from);
+        new (to) target_t{std::move(target)};
+        target.~target_t();
+      },
+      [](void* storage) noexcept {
+        static_cast<target_t*>(storage)->~target_t();
+      }};
+
+  const vtable* vtbl_{};
+  alignas(std::max_align_t) std::byte storage_[BYTES];
+};
+
+}}} // namespace corvid::container::inplacefn
@@ -19,6 +19,7 @@
 #include "arena_allocator.h"
 #include "opt_find.h"
 #include "../enums.h"
+#include "../instrument.h"
 #include "../strings/cstring_view.h"
 
 namespace corvid { inline namespace container { inline namespace intern {
@@ -36,6 +37,9 @@ class restrict_intern_construction {
   template<typename T, SequentialEnum ID, typename TR>
   friend class intern_table;
 
+  template<typename T, SequentialEnum ID, size_t SH, typename TR>
+  friend class sharded_intern_table;
+
   template<typename T, SequentialEnum ID>
   friend struct intern_test;
 };
@@ -50,6 +54,9 @@ struct intern_traits {};
 template<typename T, SequentialEnum ID, typename TR>
 class intern_table;
 
+template<typename T, SequentialEnum ID, size_t SH, typename TR>
+class sharded_intern_table;
+
 // Overview:
 // An intern table stores unique values of type `T` and allows them to be
 // looked up by ID or by value. The address of the value is its identity, so
@@ -91,6 +98,8 @@ public:
       : value_{&value}, id_{id} {}
   constexpr interned_value(allow, const value_t* value, id_t id)
       : value_{value}, id_{id} {}
+  constexpr interned_value(allow, const value_t* value, id_t id, size_t hash)
+      : value_{value}, id_{id}, hash_{hash} {}
 
   constexpr interned_value() noexcept = default;
   constexpr interned_value(const interned_value&) noexcept = default;
@@ -119,6 +128,13 @@ public:
   // Accessors.
   [[nodiscard]] constexpr id_t id() const noexcept { return id_; }
 
+  // The value's hash, computed once at intern time and cached, so hashing an
+  // interned value is a single load instead of a traversal of the bytes. It
+  // matches the hash of the key view (for strings, of the
+  // `std::string_view`), so transparent lookups agree with it. Zero when the
+  // instance did not come from an intern table.
+  [[nodiscard]] constexpr size_t hash() const noexcept { return hash_; }
+
   [[nodiscard]] constexpr bool has_value() const noexcept { return value_; }
   [[nodiscard]] constexpr const value_t& value() const { return *value_; }
 
@@ -180,6 +196,7 @@ public:
 private:
   const value_t* value_{};
   id_t id_{};
+  size_t hash_{};
 };
 
 // Intern traits define the data structures used for the specified type.
@@ -216,6 +233,7 @@ struct intern_traits<T, ID> {
   using key_t = indirect_hash_key<value_t>;
   using lookup_by_id_t = std::deque<value_t>;
   using lookup_by_value_t = std::unordered_map<key_t, id_t>;
+  using hashes_t = std::deque<size_t>;
 };
 
 // TODO: A deque is only being used because we want to be able to enlarge
@@ -247,6 +265,7 @@ struct intern_traits<std::string, ID> {
   using key_t = std::string_view;
   using lookup_by_id_t = arena_deque<arena_value_t>;
   using lookup_by_value_t = arena_map<key_t, id_t>;
+  using hashes_t = arena_deque<size_t>;
 };
 
 // Intern table of `T` values, indexed by `ID`, using the traits `TR`.
@@ -269,6 +288,7 @@ public:
   using key_t = typename TR::key_t;
   using lookup_by_id_t = typename TR::lookup_by_id_t;
   using lookup_by_value_t = typename TR::lookup_by_value_t;
+  using hashes_t = typename TR::hashes_t;
   static_assert(sizeof(arena_value_t) == sizeof(value_t));
 
   // Effectively-private constructor.
@@ -276,7 +296,7 @@ public:
       : min_id_{min_id}, max_id_{max_id},
         lookup_by_id_{arena_construct<lookup_by_id_t>(arena_)},
         lookup_by_value_{arena_construct<lookup_by_value_t>(arena_)},
-        next_{next} {
+        hashes_{arena_construct<hashes_t>(arena_)}, next_{next} {
     assert(min_id);
     assert(min_id_ < max_id_);
     // TODO: Consider whether we should disable `next` if it's specified.
@@ -313,17 +333,67 @@ public:
   // When full, `intern` fails.
   bool is_full() const { return sync.is_disabled(); }
 
+  // The ID range this table covers.
+  [[nodiscard]] id_t min_id() const noexcept { return min_id_; }
+  [[nodiscard]] id_t max_id() const noexcept { return max_id_; }
+
+  // Freeze the table. No further values can be interned, and by-value lookups
+  // switch to an immutable open-addressing index, compacted into the arena
+  // and probed without taking the lock. Call once the write-heavy startup
+  // phase is over; the table is read-only from then on. Idempotent.
+  //
+  // Lookups by ID were already lock-free once the synchronizer was disabled,
+  // since the values themselves never move.
+  void freeze(const lock& attestation = {}) {
+    attestation(sync);
+    if (frozen_.load(std::memory_order_relaxed)) return;
+    extensible_arena::scope s{arena_};
+    const auto count = lookup_by_id_.size();
+
+    // Size to a power of two with a load factor of at most one half.
+    size_t capacity = 16;
+    while (capacity < count * 2) capacity <<= 1;
+    auto* slots = static_cast<frozen_slot*>(extensible_arena::allocate(
+        capacity * sizeof(frozen_slot), cache_line_size));
+    for (size_t ndx = 0; ndx != capacity; ++ndx)
+      new (slots + ndx) frozen_slot{};
+
+    frozen_mask_ = capacity - 1;
+    for (size_t ndx = 0; ndx != count; ++ndx) {
+      const auto* found_value =
+          reinterpret_cast<const value_t*>(&lookup_by_id_[ndx]);
+      const auto hash = hashes_[ndx];
+      auto slot_ndx = hash & frozen_mask_;
+      while (slots[slot_ndx].value_)
+        slot_ndx = (slot_ndx + 1) & frozen_mask_;
+      slots[slot_ndx] = {hash, found_value,
+          static_cast<id_t>(*min_id_ + ndx)};
+    }
+
+    // Publish the index, then break the lock; readers that see the
+    // synchronizer disabled also see the index.
+    frozen_.store(slots, std::memory_order_release);
+    sync.disable();
+  }
+
+  // Whether `freeze` has been called.
+  [[nodiscard]] bool is_frozen() const {
+    return frozen_.load(std::memory_order_relaxed) != nullptr;
+  }
+
   // Get interned value by ID. If not found, returns empty. Chains to next
   // table if necessary. See also: `operator()`.
   [[nodiscard]] interned_value_t
   get(id_t id, const lock& attestation = {}) const {
     attestation(sync);
     const value_t* found_value{};
-    if (id >= min_id_ && id <= max_id_)
+    size_t hash{};
+    if (id >= min_id_ && id <= max_id_) {
       found_value = find_by_id(id);
-    else if (next_)
+      if (found_value) hash = hashes_[*id - *min_id_];
+    } else if (next_)
       return next_->get(id);
-    return {allow::ctor, found_value, id};
+    return {allow::ctor, found_value, id, hash};
   }
 
   // Get interned value by (transparent) value. If not found, returns empty.
@@ -333,17 +403,22 @@ public:
   requires Viewable<T, U>
   [[nodiscard]] interned_value_t
   get(const U& value, const lock& attestation = {}) const {
+    // The frozen index is immutable, so the wait-free path skips the lock.
+    if (const auto* slots = frozen_.load(std::memory_order_acquire))
+      return frozen_get(slots, value);
     attestation(sync);
     id_t id{};
     const value_t* found_value{};
+    size_t hash{};
     if (auto id_ptr = find_opt(lookup_by_value_, key_t{value})) {
       id = *id_ptr;
       const auto index = *id - *min_id_;
       found_value = reinterpret_cast<const value_t*>(&lookup_by_id_[index]);
+      hash = hashes_[index];
     } else if (next_)
       return next_->get(value, attestation);
 
-    return {allow::ctor, found_value, id};
+    return {allow::ctor, found_value, id, hash};
   }
 
   // Interns a value. If the value is already interned, returns the existing
@@ -358,17 +433,42 @@ public:
 
     // If we found it, or if we have no more room, return what we have.
     auto iv = get(std::forward<U>(value), attestation);
+    if (iv)
+      CORVID_INSTRUMENT_COUNT(intern_hits, 1);
+    else
+      CORVID_INSTRUMENT_COUNT(intern_misses, 1);
     if (iv || sync.is_disabled()) return iv;
 
     extensible_arena::scope s{arena_};
     const auto id = static_cast<id_t>(*min_id_ + lookup_by_id_.size());
+    // Hash once, now, and keep it next to the value; lookups hand it back so
+    // hashing an interned value never touches the bytes again.
+    const auto hash = hash_key(value);
     auto& found_value = lookup_by_id_.emplace_back(std::forward<U>(value));
+    hashes_.push_back(hash);
     lookup_by_value_.emplace(key_t{found_value}, id);
 
     // After the last entry, we don't need to sync anymore.
     if (id == max_id_) sync.disable();
 
-    return {allow::ctor, reinterpret_cast<const value_t*>(&found_value), id};
+    return {allow::ctor, reinterpret_cast<const value_t*>(&found_value), id,
+        hash};
+  }
+
+  // Interns a batch of values, returning the interned values in input order.
+  // The lock is acquired once for the whole batch instead of once per value,
+  // which is markedly cheaper when replaying a large symbol universe. As with
+  // `intern`, values that arrive after the table fills come back empty.
+  template<Range R>
+  requires Viewable<T, std::ranges::range_value_t<R>>
+  [[nodiscard]] std::vector<interned_value_t> intern_all(R&& range) {
+    std::vector<interned_value_t> results;
+    if constexpr (std::ranges::sized_range<R>)
+      results.reserve(std::ranges::size(range));
+    extensible_arena::scope s{arena_};
+    lock batch_lock{sync};
+    for (auto&& value : range) results.push_back(intern(value, batch_lock));
+    return results;
   }
 
   // Get by ID. If not found, returns empty ID and value.
@@ -410,12 +510,25 @@ public:
   const breakable_synchronizer sync;
 
 private:
+  // Slot in the immutable index built by `freeze`. The stored hash lets the
+  // probe loop reject mismatches without touching the value.
+  struct frozen_slot {
+    size_t hash_{};
+    const value_t* value_{};
+    id_t id_{};
+  };
+
+  static constexpr size_t cache_line_size = 64;
+
   extensible_arena arena_{4096};
   const id_t min_id_;
   const id_t max_id_;
   lookup_by_id_t& lookup_by_id_;
   lookup_by_value_t& lookup_by_value_;
+  hashes_t& hashes_;
   const_pointer next_;
+  std::atomic<const frozen_slot*> frozen_{};
+  size_t frozen_mask_{};
 
   // TODO: Add real or fake arena allocator, depending on traits. Then create
   // real or fake scopes in the methods that can allocate.
@@ -426,6 +539,42 @@ private:
     if (index >= lookup_by_id_.size()) return nullptr;
     return reinterpret_cast<const value_t*>(&lookup_by_id_[index]);
   }
+
+  // Hash a value, or a view of one, the same way the key does, so that the
+  // frozen index agrees with `lookup_by_value_`.
+  template<typename U>
+  [[nodiscard]] static size_t hash_key(const U& value) {
+    if constexpr (requires { std::hash<key_t>{}(value); })
+      return std::hash<key_t>{}(value);
+    else
+      return std::hash<key_t>{}(key_t{value});
+  }
+
+  // Compare a stored value against a (possibly transparent) probe value.
+  template<typename U>
+  [[nodiscard]] static bool equal_key(const value_t& stored, const U& value) {
+    if constexpr (requires { typename key_t::hash_equal_to; })
+      return typename key_t::hash_equal_to{}(key_t{stored}, value);
+    else
+      return key_t{stored} == key_t{value};
+  }
+
+  // Probe the frozen index. Linear probing over a half-empty power-of-two
+  // table; an empty slot ends the probe as a miss. Chains to next table if
+  // necessary.
+  template<typename U>
+  [[nodiscard]] interned_value_t
+  frozen_get(const frozen_slot* slots, const U& value) const {
+    const auto hash = hash_key(value);
+    for (auto ndx = hash & frozen_mask_;; ndx = (ndx + 1) & frozen_mask_) {
+      const auto& slot = slots[ndx];
+      if (!slot.value_) break;
+      if (slot.hash_ == hash && equal_key(*slot.value_, value))
+        return {allow::ctor, slot.value_, slot.id_, slot.hash_};
+    }
+    if (next_) return next_->get(value);
+    return {allow::ctor, nullptr, id_t{}};
+  }
 };
 
 // Inline constructors.
@@ -452,6 +601,200 @@ interned_value<T, ID>::interned_value(intern_table<T, ID, TR>& table,
   *this = table.intern(std::forward<U>(value), attestation);
 }
 
+// Sharded intern table, for interning from many threads at once.
+//
+// Carves the ID range into `SH` contiguous spans, each backed by its own
+// `intern_table` with its own lock and arena. A value is routed to a shard by
+// hashing it, so threads interning distinct values mostly hit distinct locks,
+// and lookups by ID route arithmetically. The `interned_value` and ID
+// semantics are unchanged: IDs are unique across the whole table, and the
+// address of the interned value is its identity.
+//
+// Because the same span of IDs must always hash to the same shard, shards
+// cannot be rebalanced: a shard that fills up fails further interning of the
+// values that route to it, even if other shards have room. Size the range
+// generously.
+//
+// Unlike `intern_table`, there is no whole-table lock to attest to, so the
+// methods do not take an attestation; each call locks only the one shard it
+// touches.
+template<typename T, SequentialEnum ID, size_t SH = 8,
+    typename TR = intern_traits<T, ID>>
+class sharded_intern_table {
+  using allow = restrict_intern_construction::allow;
+
+public:
+  using shard_t = intern_table<T, ID, TR>;
+  using pointer = std::shared_ptr<sharded_intern_table>;
+  using value_t = typename TR::value_t;
+  using id_t = typename TR::id_t;
+  using interned_value_t = typename TR::interned_value_t;
+  using key_t = typename TR::key_t;
+  static constexpr size_t shard_count = SH;
+  static_assert(shard_count > 0);
+
+  // Effectively-private constructor.
+  sharded_intern_table(allow, id_t min_id, id_t max_id)
+      : min_id_{min_id}, max_id_{max_id},
+        span_{(size_t(*max_id - *min_id) + 1) / shard_count} {
+    // Each shard needs a span of at least two, as its range is exclusive.
+    assert(span_ > 1);
+    auto lo = min_id_;
+    for (size_t ndx = 0; ndx != shard_count; ++ndx) {
+      // The last shard absorbs the remainder of the range.
+      const auto hi = (ndx + 1 == shard_count)
+                          ? max_id_
+                          : static_cast<id_t>(*lo + span_ - 1);
+      shards_[ndx] = shard_t::make(lo, hi);
+      lo = hi + 1;
+    }
+  }
+
+  sharded_intern_table(const sharded_intern_table&) = delete;
+  sharded_intern_table& operator=(const sharded_intern_table&) = delete;
+
+  // Make a sharded intern table for a range of IDs, defaulted as in
+  // `intern_table::make`. The range must be at least `shard_count` wide.
+  [[nodiscard]] static pointer
+  make(id_t min_id = id_t{}, id_t max_id = id_t{}) {
+    if (!min_id) ++min_id;
+    if (!max_id)
+      max_id = static_cast<id_t>(
+          std::numeric_limits<as_underlying_t<id_t>>::max() - 1);
+    return std::make_shared<sharded_intern_table>(allow::ctor, min_id, max_id);
+  }
+
+  // When full, `intern` fails for the values routed to the full shard.
+  [[nodiscard]] bool is_full() const {
+    for (auto& shard : shards_)
+      if (!shard->is_full()) return false;
+    return true;
+  }
+
+  // Freeze every shard, switching all lookups to their wait-free paths.
+  void freeze() {
+    for (auto& shard : shards_) shard->freeze();
+  }
+
+  // Get interned value by ID. If not found, returns empty. See also:
+  // `operator()`.
+  [[nodiscard]] interned_value_t get(id_t id) const {
+    if (id < min_id_ || id > max_id_) return {allow::ctor, nullptr, id};
+    return shard_by_id(id).get(id);
+  }
+
+  // Get interned value by (transparent) value. If not found, returns empty.
+  // See also: `operator()` and `operator[] const`.
+  template<typename U>
+  requires Viewable<T, U>
+  [[nodiscard]] interned_value_t get(const U& value) const {
+    return shard_by_value(value).get(value);
+  }
+
+  // Interns a value into the shard it hashes to. If the value is already
+  // interned, returns the existing one. Can only fail if that shard is full,
+  // in which case it returns an empty instance. See also: `operator[]`.
+  template<typename U>
+  requires Viewable<T, U>
+  [[nodiscard]] interned_value_t intern(U&& value) {
+    return shard_by_value(value).intern(std::forward<U>(value));
+  }
+
+  // Interns a batch of values, returning the interned values in input order.
+  // Hashes out of line to group the values by shard, then interns each group
+  // under a single lock acquisition on its shard.
+  template<Range R>
+  requires Viewable<T, std::ranges::range_value_t<R>> &&
+           std::ranges::random_access_range<R>
+  [[nodiscard]] std::vector<interned_value_t> intern_all(R&& range) {
+    std::vector<interned_value_t> results;
+    results.reserve(std::ranges::size(range));
+    std::array<std::vector<size_t>, shard_count> groups;
+    for (auto&& value : range) {
+      groups[shard_ndx(value)].push_back(results.size());
+      results.emplace_back();
+    }
+    auto first = std::ranges::begin(range);
+    for (size_t sh = 0; sh != shard_count; ++sh) {
+      if (groups[sh].empty()) continue;
+      auto& shard = *shards_[sh];
+      lock shard_lock{shard.sync};
+      for (const auto ndx : groups[sh])
+        results[ndx] = shard.intern(first[ndx], shard_lock);
+    }
+    return results;
+  }
+
+  // Get by ID. If not found, returns empty ID and value.
+  [[nodiscard]] interned_value_t operator()(id_t id) const { return get(id); }
+
+  // Get by value. Does not intern. If not found, returns empty ID and value.
+  template<typename U>
+  requires Viewable<T, U>
+  [[nodiscard]] interned_value_t operator()(U&& value) const {
+    return get(std::forward<U>(value));
+  }
+
+  // Get unique value by value. Throws if not found.
+  template<typename U>
+  requires Viewable<T, U>
+  [[nodiscard]] const value_t& operator[](U&& value) const {
+    auto iv = get(std::forward<U>(value));
+    if (!iv) throw std::out_of_range("value not found");
+    return iv.value();
+  }
+
+  // Get unique value by value, interning if necessary. Throws if the shard it
+  // routes to is full.
+  template<typename U>
+  requires Viewable<T, U>
+  [[nodiscard]] const value_t& operator[](U&& value) {
+    auto iv = intern(std::forward<U>(value));
+    if (!iv) throw std::out_of_range("value not found");
+    return iv.value();
+  }
+
+private:
+  const id_t min_id_;
+  const id_t max_id_;
+  const size_t span_;
+  std::array<typename shard_t::pointer, shard_count> shards_;
+
+  // Route an ID to the shard whose span covers it.
+  [[nodiscard]] const shard_t& shard_by_id(id_t id) const {
+    const auto ndx = std::min(size_t(*id - *min_id_) / span_, shard_count - 1);
+    return *shards_[ndx];
+  }
+
+  // Route a value to a shard by hashing its contents. The hash must not
+  // depend on which view of the value we were handed, so it goes through the
+  // key's own hash, which is transparent where the key is indirect.
+  template<typename U>
+  [[nodiscard]] size_t shard_ndx(const U& value) const {
+    if constexpr (requires { std::hash<key_t>{}(value); })
+      return std::hash<key_t>{}(value) % shard_count;
+    else
+      return std::hash<key_t>{}(key_t{value}) % shard_count;
+  }
+
+  template<typename U>
+  [[nodiscard]] const shard_t& shard_by_value(const U& value) const {
+    return *shards_[shard_ndx(value)];
+  }
+  template<typename U>
+  [[nodiscard]] shard_t& shard_by_value(const U& value) {
+    return *shards_[shard_ndx(value)];
+  }
+};
+
 }}} // namespace corvid::container::intern
 
+// Hashing an interned value is a single load of its cached hash.
+template<typename T, corvid::sequence::SequentialEnum ID>
+struct std::hash<corvid::interned_value<T, ID>> {
+  size_t operator()(const corvid::interned_value<T, ID>& iv) const noexcept {
+    return iv.hash();
+  }
+};
+
 // TODO: Replace find with opt_find.
@@ -0,0 +1,260 @@
+// Corvid20: A general-purpose C++20 library extending std.
+// https://github.com/stevensudit/Corvid20
+//
+// Copyright 2022-2024 Steven Sudit
+//
+// Licensed under the Apache License, Version 2.0(the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#pragma once
+#include "intern.h"
+
+#include <fstream>
+
+#if __has_include(<sys/mman.h>)
+#define CORVID_HAS_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace corvid { inline namespace container { inline namespace intern {
+
+#ifdef CORVID_HAS_MMAP
+
+//
+// intern_snapshot
+//
+
+namespace details {
+
+// On-disk layout: header, then `count` entries in ID order, then the
+// open-addressing index, then the string bytes. All references are offsets
+// from the start of the file, so nothing needs fixing up on load.
+struct snapshot_header {
+  uint64_t magic{};
+  uint64_t count{};
+  int64_t min_id{};
+  uint64_t index_capacity{};
+  uint64_t entries_offset{};
+  uint64_t index_offset{};
+  uint64_t blob_offset{};
+  uint64_t file_size{};
+};
+
+struct snapshot_entry {
+  uint64_t offset{};
+  uint64_t length{};
+};
+
+// Index slot; `ndx_plus_1` is zero when empty.
+struct snapshot_slot {
+  uint64_t hash{};
+  uint64_t ndx_plus_1{};
+};
+
+inline constexpr uint64_t snapshot_magic = 0x30'53'49'56'43ull; // "CVIS0"
+
+} // namespace details
+
+// Memory-mapped, read-only snapshot of a string intern table.
+//
+// `save` serializes the interned values and a compact open-addressing index
+// to a file; `load` maps that file and serves lookups straight out of the
+// mapping, so reconstituting a table costs page faults rather than parsing
+// and re-interning. Values come back as `std::string_view`s into the
+// mapping, which stays valid for the life of the snapshot.
+//
+// The format is a same-machine cache, not an interchange format: it bakes in
+// the native byte order and the standard library's `string_view` hash, so a
+// snapshot should be rebuilt rather than copied across toolchains.
+template<SequentialEnum ID>
+class intern_snapshot {
+  using header_t = details::snapshot_header;
+  using entry_t = details::snapshot_entry;
+  using slot_t = details::snapshot_slot;
+
+public:
+  using id_t = ID;
+
+  intern_snapshot() = default;
+
+  intern_snapshot(intern_snapshot&& other) noexcept
+      : base_{std::exchange(other.base_, nullptr)},
+        size_{std::exchange(other.size_, 0)} {}
+  intern_snapshot& operator=(intern_snapshot&& other) noexcept {
+    if (this != &other) {
+      unmap();
+      base_ = std::exchange(other.base_, nullptr);
+      size_ = std::exchange(other.size_, 0);
+    }
+    return *this;
+  }
+
+  intern_snapshot(const intern_snapshot&) = delete;
+  intern_snapshot& operator=(const intern_snapshot&) = delete;
+
+  ~intern_snapshot() { unmap(); }
+
+  // Serialize a table's values and index to `path`, replacing any existing
+  // file. The table should be fully loaded (ideally frozen) first; values
+  // interned after the save are simply not in the snapshot. Returns success.
+  template<typename TR>
+  static bool
+  save(const intern_table<std::string, ID, TR>& table, cstring_view path) {
+    // Walk the dense ID range; the first miss is the end.
+    std::vector<std::string_view> values;
+    const auto min_id = table.min_id();
+    for (auto id = min_id;; ++id) {
+      auto iv = table.get(id);
+      if (!iv) break;
+      values.emplace_back(iv.value());
+    }
+    return save_values(values, *min_id, path);
+  }
+
+  // Map the snapshot at `path` read-only. Returns an empty instance on any
+  // failure, including a file that isn't a snapshot.
+  [[nodiscard]] static intern_snapshot load(cstring_view path) {
+    intern_snapshot snap;
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd == -1) return snap;
+    struct stat st {};
+    if (::fstat(fd, &st) == 0 && size_t(st.st_size) >= sizeof(header_t)) {
+      auto* base =
+          ::mmap(nullptr, size_t(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+      if (base != MAP_FAILED) {
+        snap.base_ = static_cast<const char*>(base);
+        snap.size_ = size_t(st.st_size);
+        if (!snap.validate()) snap.unmap();
+      }
+    }
+    ::close(fd);
+    return snap;
+  }
+
+  [[nodiscard]] explicit operator bool() const noexcept { return base_; }
+
+  // Number of interned values.
+  [[nodiscard]] size_t size() const noexcept { return header().count; }
+
+  // Lowest ID in the snapshot.
+  [[nodiscard]] id_t min_id() const noexcept {
+    return static_cast<id_t>(header().min_id);
+  }
+
+  // Get value by ID. If not found, returns an empty view.
+  [[nodiscard]] std::string_view operator()(id_t id) const noexcept {
+    const auto& hdr = header();
+    const auto ndx = uint64_t(*id - hdr.min_id);
+    if (*id < hdr.min_id || ndx >= hdr.count) return {};
+    return value_at(ndx);
+  }
+
+  // Get ID by value. If not found, returns the zero ID.
+  [[nodiscard]] id_t operator()(std::string_view value) const noexcept {
+    const auto& hdr = header();
+    const auto* slots =
+        reinterpret_cast<const slot_t*>(base_ + hdr.index_offset);
+    const auto mask = hdr.index_capacity - 1;
+    const auto hash = std::hash<std::string_view>{}(value);
+    for (auto ndx = hash & mask;; ndx = (ndx + 1) & mask) {
+      const auto& slot = slots[ndx];
+      if (!slot.ndx_plus_1) return id_t{};
+      if (slot.hash == hash && value_at(slot.ndx_plus_1 - 1) == value)
+        return static_cast<id_t>(hdr.min_id + int64_t(slot.ndx_plus_1 - 1));
+    }
+  }
+
+private:
+  const char* base_{};
+  size_t size_{};
+
+  [[nodiscard]] const header_t& header() const noexcept {
+    return *reinterpret_cast<const header_t*>(base_);
+  }
+
+  [[nodiscard]] std::string_view value_at(uint64_t ndx) const noexcept {
+    const auto& hdr = header();
+    const auto* entries =
+        reinterpret_cast<const entry_t*>(base_ + hdr.entries_offset);
+    return {base_ + entries[ndx].offset, entries[ndx].length};
+  }
+
+  void unmap() noexcept {
+    if (base_) ::munmap(const_cast<char*>(base_), size_);
+    base_ = nullptr;
+    size_ = 0;
+  }
+
+  // Cheap structural checks so a bad file fails load instead of lookups.
+  [[nodiscard]] bool validate() const noexcept {
+    const auto& hdr = header();
+    if (hdr.magic != details::snapshot_magic) return false;
+    if (hdr.file_size != size_) return false;
+    if (hdr.index_capacity == 0 ||
+        (hdr.index_capacity & (hdr.index_capacity - 1)))
+      return false;
+    return hdr.entries_offset + hdr.count * sizeof(entry_t) <= size_ &&
+           hdr.index_offset + hdr.index_capacity * sizeof(slot_t) <= size_ &&
+           hdr.blob_offset <= size_;
+  }
+
+  static bool save_values(const std::vector<std::string_view>& values,
+      int64_t min_id, cstring_view path) {
+    const auto count = values.size();
+    size_t capacity = 16;
+    while (capacity < count * 2) capacity <<= 1;
+
+    header_t hdr;
+    hdr.magic = details::snapshot_magic;
+    hdr.count = count;
+    hdr.min_id = min_id;
+    hdr.index_capacity = capacity;
+    hdr.entries_offset = sizeof(header_t);
+    hdr.index_offset = hdr.entries_offset + count * sizeof(entry_t);
+    hdr.blob_offset = hdr.index_offset + capacity * sizeof(slot_t);
+
+    std::vector<entry_t> entries(count);
+    auto offset = hdr.blob_offset;
+    for (size_t ndx = 0; ndx != count; ++ndx) {
+      entries[ndx] = {offset, values[ndx].size()};
+      offset += values[ndx].size();
+    }
+    hdr.file_size = offset;
+
+    std::vector<slot_t> slots(capacity);
+    const auto mask = capacity - 1;
+    for (size_t ndx = 0; ndx != count; ++ndx) {
+      const auto hash = std::hash<std::string_view>{}(values[ndx]);
+      auto slot_ndx = hash & mask;
+      while (slots[slot_ndx].ndx_plus_1)
+        slot_ndx = (slot_ndx + 1) & mask;
+      slots[slot_ndx] = {hash, ndx + 1};
+    }
+
+    std::ofstream out{path.c_str(), std::ios::binary | std::ios::trunc};
+    if (!out) return false;
+    out.write(reinterpret_cast<const char*>(&hdr), sizeof(hdr));
+    out.write(reinterpret_cast<const char*>(entries.data()),
+        std::streamsize(count * sizeof(entry_t)));
+    out.write(reinterpret_cast<const char*>(slots.data()),
+        std::streamsize(capacity * sizeof(slot_t)));
+    for (const auto& value : values)
+      out.write(value.data(), std::streamsize(value.size()));
+    return bool(out);
+  }
+};
+
+#endif // CORVID_HAS_MMAP
+
+}}} // namespace corvid::container::intern
@@ -20,7 +20,10 @@
 #include "containers_shared.h"
 #include "../strings.h"
 #include "../enums.h"
+#include <atomic>
 #include <cassert>
+#include <span>
+#include <thread>
 
 namespace corvid { inline namespace intervals {
 
@@ -412,6 +415,138 @@ constexpr auto make_interval() noexcept {
   return interval<E, U>{E{}, max_value<E>()};
 }
 
+//
+// Batch kernels
+//
+// These loop bodies are branch-free, so the compiler can vectorize them and
+// classify many values per instruction instead of one comparison pair at a
+// time. The interval operands of `intersect` and `unite` must be non-empty;
+// empty operands don't have a meaningful min/max.
+//
+
+// Batch membership: for each value, writes whether it falls within `iv`.
+// Returns how many did.
+template<typename V, typename U>
+size_t contains_all(const interval<V, U>& iv, std::span<const V> values,
+    std::span<bool> out) noexcept {
+  assert(values.size() == out.size());
+  size_t count{};
+  if (iv.empty()) {
+    std::fill(out.begin(), out.end(), false);
+    return count;
+  }
+  const auto lo = iv.min(), hi = iv.max();
+  for (size_t ndx = 0; ndx < values.size(); ++ndx) {
+    const auto u = static_cast<U>(values[ndx]);
+    const bool in = (u >= lo) & (u <= hi);
+    out[ndx] = in;
+    count += in;
+  }
+  return count;
+}
+
+// Pairwise intersection: `out[ndx]` covers the values common to `a[ndx]` and
+// `b[ndx]`, and is empty when they don't overlap.
+template<typename V, typename U>
+void intersect(std::span<const interval<V, U>> a,
+    std::span<const interval<V, U>> b,
+    std::span<interval<V, U>> out) noexcept {
+  assert(a.size() == b.size() && a.size() == out.size());
+  for (size_t ndx = 0; ndx < a.size(); ++ndx) {
+    assert(!a[ndx].empty() && !b[ndx].empty());
+    const auto lo = std::max(a[ndx].min(), b[ndx].min());
+    const auto hi = std::min(a[ndx].max(), b[ndx].max());
+    out[ndx] = interval<V, U>{};
+    if (lo <= hi) out[ndx].min(lo).max(hi);
+  }
+}
+
+// Pairwise union: `out[ndx]` is the smallest interval covering both `a[ndx]`
+// and `b[ndx]`, including any gap between them.
+template<typename V, typename U>
+void unite(std::span<const interval<V, U>> a,
+    std::span<const interval<V, U>> b,
+    std::span<interval<V, U>> out) noexcept {
+  assert(a.size() == b.size() && a.size() == out.size());
+  for (size_t ndx = 0; ndx < a.size(); ++ndx) {
+    assert(!a[ndx].empty() && !b[ndx].empty());
+    out[ndx] = interval<V, U>{};
+    out[ndx]
+        .min(std::min(a[ndx].min(), b[ndx].min()))
+        .max(std::max(a[ndx].max(), b[ndx].max()));
+  }
+}
+
+//
+// Parallel driver
+//
+// An `interval` is a natural work descriptor for data-parallel loops: it
+// names a contiguous range of values without materializing them. `partition`
+// carves one into sub-intervals, and `parallel_for_each` drives a function
+// over them from a small per-call pool of threads.
+//
+
+// Divide `iv` into up to `n_chunks` contiguous sub-intervals that cover it
+// exactly, each within one element of the others in size. Returns fewer
+// chunks when the interval has fewer values than requested, and none at all
+// when it's empty.
+template<typename V, typename U>
+[[nodiscard]] std::vector<interval<V, U>>
+partition(const interval<V, U>& iv, size_t n_chunks) {
+  std::vector<interval<V, U>> chunks;
+  if (iv.empty() || !n_chunks) return chunks;
+  const auto total = iv.size();
+  if (n_chunks > total) n_chunks = total;
+  chunks.reserve(n_chunks);
+  const auto base = total / n_chunks, extra = total % n_chunks;
+  auto lo = iv.min();
+  for (size_t ndx = 0; ndx < n_chunks; ++ndx) {
+    const auto len = static_cast<U>(base + (ndx < extra));
+    chunks.emplace_back().min(lo).max(lo + len - 1);
+    lo += len;
+  }
+  return chunks;
+}
+
+// Invoke `fn` on every value in `iv`, in parallel. The interval is cut into
+// several chunks per thread, and idle threads claim whole chunks from a
+// shared cursor, so a thread that finishes its work early takes over chunks
+// that slower threads never reached. Blocks until every value has been
+// visited.
+//
+// `fn` is called concurrently from multiple threads and so must be
+// thread-safe with respect to whatever it touches; it must not throw. Small
+// intervals, and a `n_threads` of 1, degrade to a plain serial loop.
+template<typename V, typename U, typename FN>
+void parallel_for_each(const interval<V, U>& iv, FN&& fn,
+    size_t n_threads = 0) {
+  if (iv.empty()) return;
+  if (!n_threads)
+    n_threads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+
+  // A few chunks per thread, so uneven per-value costs rebalance.
+  constexpr size_t chunks_per_thread = 4;
+  const auto chunks = partition(iv, n_threads * chunks_per_thread);
+  if (n_threads == 1 || chunks.size() <= 1) {
+    for (auto v : iv) fn(v);
+    return;
+  }
+
+  std::atomic<size_t> next_chunk{};
+  auto worker = [&] {
+    for (auto ndx = next_chunk.fetch_add(1, std::memory_order_relaxed);
+        ndx < chunks.size();
+        ndx = next_chunk.fetch_add(1, std::memory_order_relaxed))
+      for (auto v : chunks[ndx]) fn(v);
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(n_threads - 1);
+  for (size_t t = 1; t < n_threads; ++t) threads.emplace_back(worker);
+  worker();
+  for (auto& t : threads) t.join();
+}
+
 // `T` must be an an `interval`.
 template<typename T>
 concept Interval = is_specialization_of_v<T, interval>;
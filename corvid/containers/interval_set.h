@@ -0,0 +1,246 @@
+// Corvid20: A general-purpose C++20 library extending std.
+// https://github.com/stevensudit/Corvid20
+//
+// Copyright 2022-2024 Steven Sudit
+//
+// Licensed under the Apache License, Version 2.0(the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#pragma once
+#include "interval.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace corvid { inline namespace intervals {
+
+//
+// interval_set
+//
+
+// An ordered set of disjoint closed intervals, kept coalesced in a flat,
+// sorted `std::vector`.
+//
+// Conceptually, this is a set of integers stored run-length-encoded: inserting
+// a value or an `interval` of values merges it with any overlapping or
+// adjacent runs, so iteration always yields the minimal list of disjoint
+// intervals, in order. Stabbing queries (`contains`, `find`) are a single
+// binary search over contiguous memory, which is the point: no nodes, no
+// pointer chasing.
+//
+// Mutation is O(n) in the number of intervals, since the vector has to
+// shift, so this favors query-heavy workloads such as IP-range or time-range
+// indexes.
+//
+// Since the elements are plain `interval`s, the existing append/format
+// support applies: `strings::join` over `intervals()` does the right thing.
+template<typename V = int64_t, typename U = as_underlying_t<V>>
+requires Integer<V> || StdEnum<V>
+class interval_set {
+public:
+  using interval_t = interval<V, U>;
+  using storage_t = std::vector<interval_t>;
+  using value_type = interval_t;
+  using const_iterator = typename storage_t::const_iterator;
+
+  interval_set() = default;
+  interval_set(std::initializer_list<interval_t> ivs) {
+    for (const auto& iv : ivs) insert(iv);
+  }
+
+  // Iteration is over the disjoint intervals, in order.
+  [[nodiscard]] const_iterator begin() const noexcept {
+    return intervals_.begin();
+  }
+  [[nodiscard]] const_iterator end() const noexcept {
+    return intervals_.end();
+  }
+  [[nodiscard]] const storage_t& intervals() const noexcept {
+    return intervals_;
+  }
+
+  // Size is the number of disjoint intervals; cardinality is the total
+  // number of values they cover.
+  [[nodiscard]] size_t size() const noexcept { return intervals_.size(); }
+  [[nodiscard]] bool empty() const noexcept { return intervals_.empty(); }
+  [[nodiscard]] size_t cardinality() const noexcept {
+    size_t total{};
+    for (const auto& iv : intervals_) total += iv.size();
+    return total;
+  }
+
+  void clear() noexcept { intervals_.clear(); }
+
+  // Stabbing query: whether `v` falls in any interval.
+  [[nodiscard]] bool contains(V v) const noexcept { return find(v); }
+
+  // The disjoint interval containing `v`, or nullptr.
+  [[nodiscard]] const interval_t* find(V v) const noexcept {
+    const auto u = static_cast<U>(v);
+    auto it = std::upper_bound(intervals_.begin(), intervals_.end(), u,
+        [](U u, const interval_t& i) { return u < i.min(); });
+    if (it == intervals_.begin()) return nullptr;
+    --it;
+    return it->max() >= u ? &*it : nullptr;
+  }
+
+  // Insert a value or an interval of values, coalescing with any runs it
+  // overlaps or abuts.
+  void insert(V v) { insert(interval_t{v}); }
+  void insert(const interval_t& iv) {
+    assert(!iv.invalid());
+    if (iv.empty()) return;
+    // Everything from the first interval that overlaps or abuts `iv` to the
+    // last merges into one.
+    auto first = std::lower_bound(intervals_.begin(), intervals_.end(),
+        iv.min(),
+        [](const interval_t& i, U m) { return i.max() + 1 < m; });
+    auto last = std::upper_bound(first, intervals_.end(), iv.max(),
+        [](U m, const interval_t& i) { return m + 1 < i.min(); });
+    auto lo = iv.min(), hi = iv.max();
+    if (first != last) {
+      lo = std::min(lo, first->min());
+      hi = std::max(hi, std::prev(last)->max());
+    }
+    first = intervals_.erase(first, last);
+    intervals_.insert(first, interval_t{}.min(lo).max(hi));
+  }
+
+  // Erase a value or an interval of values, splitting any runs that extend
+  // past either edge. Returns whether anything was erased.
+  bool erase(V v) { return erase(interval_t{v}); }
+  bool erase(const interval_t& iv) {
+    assert(!iv.invalid());
+    if (iv.empty()) return false;
+    auto first = std::lower_bound(intervals_.begin(), intervals_.end(),
+        iv.min(), [](const interval_t& i, U m) { return i.max() < m; });
+    auto last = std::upper_bound(first, intervals_.end(), iv.max(),
+        [](U m, const interval_t& i) { return m < i.min(); });
+    if (first == last) return false;
+    interval_t left{}, right{};
+    if (first->min() < iv.min()) left.min(first->min()).max(iv.min() - 1);
+    if (const auto& back = *std::prev(last); back.max() > iv.max())
+      right.min(iv.max() + 1).max(back.max());
+    first = intervals_.erase(first, last);
+    if (!right.empty()) first = intervals_.insert(first, right);
+    if (!left.empty()) intervals_.insert(first, left);
+    return true;
+  }
+
+private:
+  storage_t intervals_;
+};
+
+//
+// interval_map
+//
+
+// An ordered map from disjoint closed intervals to values, kept coalesced in
+// a flat, sorted `std::vector` of (interval, value) pairs.
+//
+// `assign` overwrites the covered range, splitting any entries that extend
+// past its edges, and then merges with abutting neighbors that map to an
+// equal value, so iteration always yields the minimal list of disjoint
+// entries, in order. As with `interval_set`, lookup is one binary search
+// over contiguous memory and mutation is O(n).
+template<typename V, typename VAL, typename U = as_underlying_t<V>>
+requires Integer<V> || StdEnum<V>
+class interval_map {
+public:
+  using interval_t = interval<V, U>;
+  using value_type = std::pair<interval_t, VAL>;
+  using storage_t = std::vector<value_type>;
+  using const_iterator = typename storage_t::const_iterator;
+
+  interval_map() = default;
+
+  // Iteration is over the disjoint entries, in order.
+  [[nodiscard]] const_iterator begin() const noexcept {
+    return entries_.begin();
+  }
+  [[nodiscard]] const_iterator end() const noexcept { return entries_.end(); }
+  [[nodiscard]] const storage_t& entries() const noexcept { return entries_; }
+
+  [[nodiscard]] size_t size() const noexcept { return entries_.size(); }
+  [[nodiscard]] bool empty() const noexcept { return entries_.empty(); }
+
+  void clear() noexcept { entries_.clear(); }
+
+  // Stabbing query: whether `v` falls in any entry.
+  [[nodiscard]] bool contains(V v) const noexcept { return find(v); }
+
+  // The value mapped for `v`, or nullptr.
+  [[nodiscard]] const VAL* find(V v) const noexcept {
+    const auto u = static_cast<U>(v);
+    auto it = std::upper_bound(entries_.begin(), entries_.end(), u,
+        [](U u, const value_type& e) { return u < e.first.min(); });
+    if (it == entries_.begin()) return nullptr;
+    --it;
+    return it->first.max() >= u ? &it->second : nullptr;
+  }
+
+  // Map an interval of values to `value`, overwriting whatever part of the
+  // range was previously mapped.
+  void assign(V v, VAL value) { assign(interval_t{v}, std::move(value)); }
+  void assign(const interval_t& iv, VAL value) {
+    assert(!iv.invalid());
+    if (iv.empty()) return;
+    erase(iv);
+    auto lo = iv.min(), hi = iv.max();
+    auto it = std::upper_bound(entries_.begin(), entries_.end(), lo,
+        [](U u, const value_type& e) { return u < e.first.min(); });
+    // Absorb abutting neighbors that map to an equal value.
+    if (it != entries_.begin()) {
+      auto left = std::prev(it);
+      if (left->first.max() + 1 == lo && left->second == value) {
+        lo = left->first.min();
+        it = entries_.erase(left);
+      }
+    }
+    if (it != entries_.end() && it->first.min() == hi + 1 &&
+        it->second == value) {
+      hi = it->first.max();
+      it = entries_.erase(it);
+    }
+    entries_.insert(it, {interval_t{}.min(lo).max(hi), std::move(value)});
+  }
+
+  // Unmap an interval of values, splitting any entries that extend past
+  // either edge. Returns whether anything was erased.
+  bool erase(V v) { return erase(interval_t{v}); }
+  bool erase(const interval_t& iv) {
+    assert(!iv.invalid());
+    if (iv.empty()) return false;
+    auto first = std::lower_bound(entries_.begin(), entries_.end(), iv.min(),
+        [](const value_type& e, U m) { return e.first.max() < m; });
+    auto last = std::upper_bound(first, entries_.end(), iv.max(),
+        [](U m, const value_type& e) { return m < e.first.min(); });
+    if (first == last) return false;
+    value_type left{}, right{};
+    if (first->first.min() < iv.min()) {
+      left.first.min(first->first.min()).max(iv.min() - 1);
+      left.second = first->second;
+    }
+    if (const auto& back = *std::prev(last); back.first.max() > iv.max()) {
+      right.first.min(iv.max() + 1).max(back.first.max());
+      right.second = back.second;
+    }
+    first = entries_.erase(first, last);
+    if (!right.first.empty()) first = entries_.insert(first, std::move(right));
+    if (!left.first.empty()) entries_.insert(first, std::move(left));
+    return true;
+  }
+
+private:
+  storage_t entries_;
+};
+
+}} // namespace corvid::intervals
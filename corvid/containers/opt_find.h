@@ -18,6 +18,10 @@
 #pragma once
 #include "containers_shared.h"
 #include "optional_ptr.h"
+#include <cassert>
+#include <numeric>
+#include <span>
+#include <vector>
 
 namespace corvid { inline namespace opt_find {
 
@@ -55,4 +59,43 @@ find_opt(RangeWithoutFind auto&& c, const auto& k) {
   return find_opt(c, k).has_value();
 }
 
+// Bulk lookup: probe `c` once per key, writing the `find_opt` result for
+// each into the corresponding slot of `out`. Returns how many were found.
+//
+// One call against 50-200 keys beats re-entering the container per key from
+// scattered call sites, and it works with the transparent comparators from
+// transparent.h, so string keys need no temporaries.
+template<auto field = extract_field::value, typename K, typename R>
+constexpr size_t find_opt_all(auto&& c, std::span<const K> keys,
+    std::span<R> out) {
+  assert(keys.size() == out.size());
+  size_t found{};
+  for (size_t ndx = 0; ndx < keys.size(); ++ndx) {
+    out[ndx] = find_opt<field>(c, keys[ndx]);
+    found += out[ndx].has_value();
+  }
+  return found;
+}
+
+// As `find_opt_all`, but probes in sorted key order while still writing each
+// result to its original slot. Successive probes of an ordered container
+// then walk it monotonically instead of bouncing around, which keeps the
+// upper tree levels cache-hot. Not worth it for hashed containers, whose
+// probe order is scattered regardless.
+template<auto field = extract_field::value, typename K, typename R>
+size_t find_opt_all_sorted(auto&& c, std::span<const K> keys,
+    std::span<R> out) {
+  assert(keys.size() == out.size());
+  std::vector<size_t> order(keys.size());
+  std::iota(order.begin(), order.end(), size_t{});
+  std::sort(order.begin(), order.end(),
+      [&keys](size_t l, size_t r) { return keys[l] < keys[r]; });
+  size_t found{};
+  for (const auto ndx : order) {
+    out[ndx] = find_opt<field>(c, keys[ndx]);
+    found += out[ndx].has_value();
+  }
+  return found;
+}
+
 }} // namespace corvid::opt_find
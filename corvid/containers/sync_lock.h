@@ -18,6 +18,7 @@
 #include "containers_shared.h"
 #include <atomic>
 #include <mutex>
+#include <shared_mutex>
 
 namespace corvid { inline namespace container { inline namespace sync_lock {
 
@@ -35,24 +36,59 @@ private:
   mutable std::mutex mutex_;
 };
 
+// As `synchronizer`, but a spinlock: sub-microsecond critical sections don't
+// justify the cost of a kernel wait, so contended threads busy-wait on a
+// test-and-test-and-set loop instead. Interchangeable with `synchronizer`
+// anywhere that's templated on the synchronizer type. Do not hold across
+// anything that can block.
+class spin_synchronizer {
+public:
+  void lock() const {
+    while (flag_.test_and_set(std::memory_order_acquire))
+      while (flag_.test(std::memory_order_relaxed));
+  }
+  void unlock() const { flag_.clear(std::memory_order_release); }
+
+private:
+  mutable std::atomic_flag flag_;
+};
+
+// As `synchronizer`, but reader-writer: built on `std::shared_mutex`, adding
+// a lock-shared path so that read-mostly callers don't serialize each other.
+// `lock`/`unlock` remain the exclusive path, so this is interchangeable with
+// `synchronizer`; take the shared path through `basic_shared_lock`.
+class shared_synchronizer {
+public:
+  void lock() const { mutex_.lock(); }
+  void unlock() const { mutex_.unlock(); }
+  void lock_shared() const { mutex_.lock_shared(); }
+  void unlock_shared() const { mutex_.unlock_shared(); }
+
+private:
+  mutable std::shared_mutex mutex_;
+};
+
 // Breakable synchronization object. Once the guarded resource is frozen, you
-// call `disable` and the conversion to `synchronizer` returns `nullptr`, so
-// that no actual locking is done anymore.
+// call `disable` and the conversion to the synchronizer pointer returns
+// `nullptr`, so that no actual locking is done anymore.
 //
 // If you don't want to allow someone outside the class to call `disable`, make
 // this object private and expose it through a function that returns a `const
-// synchronizer*`.
-class breakable_synchronizer {
+// SYNC*`.
+template<typename SYNC = synchronizer>
+class basic_breakable_synchronizer {
 public:
-  operator const synchronizer*() const { return sync_; };
+  operator const SYNC*() const { return sync_; };
   void disable() const { sync_ = nullptr; };
   bool is_disabled() const { return !sync_; }
 
 private:
-  synchronizer actual_sync_;
-  mutable std::atomic<const synchronizer*> sync_ = &actual_sync_;
+  SYNC actual_sync_;
+  mutable std::atomic<const SYNC*> sync_ = &actual_sync_;
 };
 
+using breakable_synchronizer = basic_breakable_synchronizer<>;
+
 // Attestation of a lock on a sync object.
 //
 // This is not a drop-in replacement for `std::lock_guard` or
@@ -92,49 +128,105 @@ private:
 // Note again how, in the above case, the caller could make their own `lock`
 // object and reuse it across multiple calls, maintaining a lock. They could
 // even construct it on the instance's `sync` member.
-class lock {
+template<typename SYNC = synchronizer>
+class basic_lock {
 public:
-  lock() = default;
+  basic_lock() = default;
 
-  explicit lock(const synchronizer& sync) : sync_{&sync} { sync_->lock(); }
-  explicit lock(const synchronizer* sync) : sync_{sync} {
+  explicit basic_lock(const SYNC& sync) : sync_{&sync} { sync_->lock(); }
+  explicit basic_lock(const SYNC* sync) : sync_{sync} {
     if (sync_) sync_->lock();
   }
 
-  lock(const lock&) = delete;
-  lock& operator=(const lock&) = delete;
+  basic_lock(const basic_lock&) = delete;
+  basic_lock& operator=(const basic_lock&) = delete;
 
-  lock(lock&& r) : sync_(r.release()) {}
-  lock& operator=(lock&& r) {
+  basic_lock(basic_lock&& r) : sync_(r.release()) {}
+  basic_lock& operator=(basic_lock&& r) {
     sync_ = r.release();
     return *this;
   }
 
-  ~lock() {
+  ~basic_lock() {
     if (sync_) sync_->unlock();
   }
 
   // Call this at top of method.
-  void operator()(const synchronizer& sync) const {
+  void operator()(const SYNC& sync) const {
     assert(!sync_ || sync_ == &sync);
     if (sync_) return;
     sync_ = &sync;
     sync_->lock();
   }
-  void operator()(const synchronizer* sync) const {
+  void operator()(const SYNC* sync) const {
+    if (sync) (*this)(*sync);
+  }
+
+  const SYNC* release() const {
+    const auto old = sync_;
+    sync_ = nullptr;
+    return old;
+  }
+
+private:
+  mutable const SYNC* sync_{};
+};
+
+using lock = basic_lock<>;
+using spin_lock = basic_lock<spin_synchronizer>;
+
+// Shared counterpart of `basic_lock`: the same attestation idiom, but
+// acquiring through the lock-shared path, so any number of readers can hold
+// one concurrently. Use for methods that only read; a writer takes a
+// `basic_lock` on the same `shared_synchronizer` and excludes them all.
+template<typename SYNC = shared_synchronizer>
+class basic_shared_lock {
+public:
+  basic_shared_lock() = default;
+
+  explicit basic_shared_lock(const SYNC& sync) : sync_{&sync} {
+    sync_->lock_shared();
+  }
+  explicit basic_shared_lock(const SYNC* sync) : sync_{sync} {
+    if (sync_) sync_->lock_shared();
+  }
+
+  basic_shared_lock(const basic_shared_lock&) = delete;
+  basic_shared_lock& operator=(const basic_shared_lock&) = delete;
+
+  basic_shared_lock(basic_shared_lock&& r) : sync_(r.release()) {}
+  basic_shared_lock& operator=(basic_shared_lock&& r) {
+    sync_ = r.release();
+    return *this;
+  }
+
+  ~basic_shared_lock() {
+    if (sync_) sync_->unlock_shared();
+  }
+
+  // Call this at top of method.
+  void operator()(const SYNC& sync) const {
+    assert(!sync_ || sync_ == &sync);
+    if (sync_) return;
+    sync_ = &sync;
+    sync_->lock_shared();
+  }
+  void operator()(const SYNC* sync) const {
     if (sync) (*this)(*sync);
   }
 
-  const synchronizer* release() const {
+  const SYNC* release() const {
     const auto old = sync_;
     sync_ = nullptr;
     return old;
   }
 
 private:
-  mutable const synchronizer* sync_{};
+  mutable const SYNC* sync_{};
 };
 
+using shared_lock = basic_shared_lock<>;
+
 // TODO: Consider whether we need an `empty_t` trick to make it easier to
 // specialize the synchronizer away.
 
@@ -16,11 +16,21 @@
 // limitations under the License.
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cassert>
 #include <chrono>
 #include <functional>
 #include <map>
 #include <queue>
 #include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "circular_buffer.h"
+#include "inplace_function.h"
+#include "../instrument.h"
 
 namespace corvid { inline namespace container {
 // This namespace is not inline, so we export just the types that the user is
@@ -36,30 +46,47 @@ using duration_t = std::chrono::milliseconds;
 struct timer_event;
 struct scheduled_event;
 
-// Callback invoked when a timer fires.
-using timer_callback_t = std::function<void(timer_event&)>;
+// Callback invoked when a timer fires. Stored inline, so arming a timer
+// does not allocate as long as the capture fits; see `inplace_function`.
+using timer_callback_t = inplace_function<void(timer_event&)>;
 
 // Callback invoked to delete a timer entry.
-using timer_entry_deleter_t = std::function<void(timer_event&)>;
+using timer_entry_deleter_t = inplace_function<void(timer_event&)>;
 
 // Callback to get the current time.
-using clock_callback_t = std::function<time_point_t()>;
+using clock_callback_t = inplace_function<time_point_t()>;
 
 // Map of timers by ID.
 using timer_map_t = std::map<timer_id_t, timer_event>;
 
+// Hashed map of timers by ID, for O(1) lookup and cancellation.
+using timer_hash_map_t = std::unordered_map<timer_id_t, timer_event>;
+
 // Priority queue of scheduled events.
 using scheduled_queue_t = std::priority_queue<scheduled_event>;
 
+// Round a time up to the next multiple of `slack` since the clock's epoch,
+// or return it unchanged when `slack` is zero. Timers that share a slack
+// land on shared batch boundaries, so they expire in one sweep instead of
+// one wakeup each.
+constexpr time_point_t coalesce(time_point_t when, duration_t slack) {
+  if (slack <= duration_t{}) return when;
+  const auto slack_d =
+      std::chrono::duration_cast<time_point_t::duration>(slack);
+  const auto rem = when.time_since_epoch() % slack_d;
+  if (rem != time_point_t::duration{}) when += slack_d - rem;
+  return when;
+}
+
 // Timer event.
 //
 // Contains full state of the event. Available to the callback handler, which
 // can modify certain fields.
 struct timer_event {
   timer_event(timer_id_t timer_id, time_point_t start_at, duration_t repeat_in,
-      time_point_t stop_at, timer_callback_t callback)
+      time_point_t stop_at, duration_t slack, timer_callback_t callback)
       : timer_id{timer_id}, start_at{start_at}, repeat_in{repeat_in},
-        stop_at{stop_at}, callback{std::move(callback)} {}
+        stop_at{stop_at}, slack{slack}, callback{std::move(callback)} {}
 
   timer_event(timer_event&&) = default;
 
@@ -82,8 +109,15 @@ struct timer_event {
   // When timer should stop firing, or empty for n/a.
   const time_point_t stop_at;
 
-  // Callback to invoke when the timer fires.
-  const timer_callback_t callback;
+  // Tolerance for late delivery, or 0 for exact. Every scheduled expiration
+  // is rounded up to the next multiple of this, per `coalesce`, which may
+  // push it past `stop_at`, in which case it never fires.
+  const duration_t slack;
+
+  // Callback to invoke when the timer fires. Not const, unlike the fields
+  // above, because the callback type is move-only and a const member would
+  // force the defaulted move constructor to copy.
+  timer_callback_t callback;
 
   // Name of the timer.
   std::string_view name;
@@ -125,7 +159,8 @@ public:
   // Set timer for a new event. Returns the event, so that mutable fields may
   // be set.
   timer_event& set(time_point_t start_at, timer_callback_t callback,
-      duration_t repeat_in = {}, time_point_t stop_at = {}) {
+      duration_t repeat_in = {}, time_point_t stop_at = {},
+      duration_t slack = {}) {
     // If all slots were filled, we'd loop forever, so just fail.
     if (events_by_id_.size() == std::numeric_limits<uint64_t>::max() - 1)
       throw std::overflow_error("Timer ID overflow");
@@ -138,7 +173,7 @@ public:
       timer_id = timer_id_t{++next_timer_id_};
       if (timer_id == timer_id_t::invalid) continue;
       auto [inserted_at, was_inserted] = events_by_id_.emplace(timer_id,
-          timer_event{timer_id, start_at, repeat_in, stop_at,
+          timer_event{timer_id, start_at, repeat_in, stop_at, slack,
               std::move(callback)});
       if (was_inserted) {
         new_event = &inserted_at->second;
@@ -146,18 +181,19 @@ public:
       }
       // TODO: Consider skipping to next open slot using binary search.
     }
-    new_event->next_at = start_at;
+    new_event->next_at = coalesce(start_at, slack);
     scheduled_events_.emplace(new_event->next_at, new_event->timer_id);
     return *new_event;
   }
 
   auto& set(duration_t start_in, timer_callback_t callback,
-      duration_t repeat_in = {}, duration_t stop_in = {}) {
+      duration_t repeat_in = {}, duration_t stop_in = {},
+      duration_t slack = {}) {
     const auto now = clock_callback_();
     const auto start_at = clock_callback_() + start_in;
     const auto stop_at =
         (stop_in == duration_t{}) ? time_point_t{} : now + stop_in;
-    return set(start_at, std::move(callback), repeat_in, stop_at);
+    return set(start_at, std::move(callback), repeat_in, stop_at, slack);
   }
 
   // TODO: Consider offering overloads that take when/expire_in and
@@ -228,6 +264,7 @@ public:
       event.next_at = callback_now;
       ++event.callbacks;
       ++callbacks;
+      CORVID_INSTRUMENT_COUNT(timer_fires, 1);
       event.callback(event);
 
       // If the callback didn't reschedule, try to schedule the next time.
@@ -253,6 +290,7 @@ public:
         continue;
       }
 
+      event.next_at = coalesce(event.next_at, event.slack);
       scheduled_events_.emplace(event.next_at, event.timer_id);
     }
 
@@ -292,7 +330,7 @@ public:
   // For testing only.
 
   void set_clock_callback(clock_callback_t callback) {
-    clock_callback_ = callback;
+    clock_callback_ = std::move(callback);
   }
 
   void set_next_timer_id(uint64_t next_timer_id) {
@@ -317,12 +355,467 @@ private:
   // been removed, in which case the ID lookup will harmlessly fail.
   scheduled_queue_t scheduled_events_;
 };
+
+// Hashed hierarchical timing wheel.
+//
+// Alternative engine to `timers`, with the same interface and the same
+// callback semantics in `tick`. Events are bucketed by due time into slots of
+// a fixed `resolution` across four wheels of 256 slots each, so `set` and
+// `cancel` are O(1) and a `tick` touches only the slots that came due,
+// instead of paying O(log n) per event on a heap. This matters when there are
+// very many outstanding timers, such as per-connection timeouts, most of
+// which are canceled before they ever fire.
+//
+// The trade-offs: events are only as precise as the resolution, firing order
+// within a single slot is unspecified, and `next_at` is a lower bound, since
+// an event parked in an outer wheel reports the time at which it cascades
+// inward rather than when it fires. Sleeping until `next_at` and ticking
+// remains correct; the sleeper just may wake, cascade, and sleep again.
+class wheel_timers {
+public:
+  explicit wheel_timers(duration_t resolution = duration_t{1})
+      : resolution_{resolution} {
+    assert(resolution_ > duration_t{});
+  }
+
+  // Get current time according to the registered clock callback.
+  auto get_now() const { return clock_callback_(); }
+
+  // Set timer for a new event. Returns the event, so that mutable fields may
+  // be set.
+  timer_event& set(time_point_t start_at, timer_callback_t callback,
+      duration_t repeat_in = {}, time_point_t stop_at = {},
+      duration_t slack = {}) {
+    // If all slots were filled, we'd loop forever, so just fail.
+    if (events_by_id_.size() == std::numeric_limits<uint64_t>::max() - 1)
+      throw std::overflow_error("Timer ID overflow");
+    ensure_started();
+
+    // After overflowing the ID, we wrap around, so we need to skip over any
+    // that are still in use.
+    timer_id_t timer_id{};
+    timer_event* new_event{};
+    for (;;) {
+      timer_id = timer_id_t{++next_timer_id_};
+      if (timer_id == timer_id_t::invalid) continue;
+      auto [inserted_at, was_inserted] = events_by_id_.emplace(timer_id,
+          timer_event{timer_id, start_at, repeat_in, stop_at, slack,
+              std::move(callback)});
+      if (was_inserted) {
+        new_event = &inserted_at->second;
+        break;
+      }
+    }
+    new_event->next_at = coalesce(start_at, slack);
+    schedule({new_event->next_at, new_event->timer_id});
+    return *new_event;
+  }
+
+  auto& set(duration_t start_in, timer_callback_t callback,
+      duration_t repeat_in = {}, duration_t stop_in = {},
+      duration_t slack = {}) {
+    const auto now = clock_callback_();
+    const auto start_at = clock_callback_() + start_in;
+    const auto stop_at =
+        (stop_in == duration_t{}) ? time_point_t{} : now + stop_in;
+    return set(start_at, std::move(callback), repeat_in, stop_at, slack);
+  }
+
+  // Cancel a timer. O(1): the slot entry goes stale and is skipped when its
+  // slot comes due, exactly as `timers` skips stale queue entries.
+  bool cancel(timer_id_t timer_id) {
+    return events_by_id_.erase(timer_id) != 0;
+  }
+
+  // Service timers, firing any that are ready. Returns the number of
+  // callbacks invoked. If `max_callbacks` is specified, it will stop after
+  // that many.
+  //
+  // See `timers::tick` for event lifespan and `next_at` semantics, which are
+  // identical, modulo firing order within one resolution slot.
+  size_t tick(size_t max_callbacks = size_t(-1)) {
+    ensure_started();
+    const auto tick_now = get_now();
+    const auto target = tick_of(tick_now);
+    size_t callbacks{};
+    for (;;) {
+      // Fire whatever already came due before advancing further.
+      while (ready_ndx_ < ready_.size()) {
+        if (callbacks >= max_callbacks) return callbacks;
+        if (fire(ready_[ready_ndx_++], tick_now)) ++callbacks;
+      }
+      ready_.clear();
+      ready_ndx_ = 0;
+      if (current_tick_ >= target) break;
+
+      // Advance one slot. Whenever a wheel wraps around to zero, first
+      // redistribute the corresponding slot of the next wheel out, which may
+      // refill the slots we're about to pass through.
+      ++current_tick_;
+      for (size_t level = 1;
+           level < wheel_count &&
+           (current_tick_ & ((uint64_t{1} << (slot_bits * level)) - 1)) == 0;
+           ++level)
+        cascade(level);
+      auto& slot = wheels_[0][current_tick_ & slot_mask];
+      ready_.insert(ready_.end(), slot.begin(), slot.end());
+      slot.clear();
+    }
+    return callbacks;
+  }
+
+  // Returns the time of the next event (which could be in the past if we're
+  // overdue). If no events, returns `default_time`.
+  //
+  // This is a lower bound: an event in an outer wheel reports its cascade
+  // time, and a canceled event still holds its slot until it comes due.
+  time_point_t next_at(time_point_t default_time = time_point_t{}) const {
+    if (ready_ndx_ < ready_.size()) return time_of(current_tick_);
+    if (events_by_id_.empty()) return default_time;
+    auto best = std::numeric_limits<uint64_t>::max();
+    for (size_t level = 0; level < wheel_count; ++level) {
+      const auto cur = current_tick_ >> (slot_bits * level);
+      for (uint64_t d = 1; d <= slots_per_wheel; ++d) {
+        if (!wheels_[level][(cur + d) & slot_mask].empty()) {
+          best = std::min(best, (cur + d) << (slot_bits * level));
+          break;
+        }
+      }
+    }
+    if (best == std::numeric_limits<uint64_t>::max()) return default_time;
+    return time_of(best);
+  }
+
+  // Returns the time until the next event, or 0 if one is ready now. If no
+  // events, returns `default_duration`, for polling. Same lower-bound caveat
+  // as `next_at`.
+  duration_t next_in(duration_t default_duration = duration_t{}) const {
+    const auto at = next_at(time_point_t::min());
+    if (at == time_point_t::min()) return default_duration;
+    auto next_delay =
+        std::chrono::duration_cast<duration_t>(at - clock_callback_());
+    if (next_delay < duration_t{}) next_delay = duration_t{};
+    return next_delay;
+  }
+
+  const auto& events() const { return events_by_id_; }
+  timer_event& event(timer_id_t timer_id) {
+    return events_by_id_.at(timer_id);
+  }
+
+  // For testing only.
+
+  void set_clock_callback(clock_callback_t callback) {
+    clock_callback_ = std::move(callback);
+  }
+
+  void set_next_timer_id(uint64_t next_timer_id) {
+    next_timer_id_ = next_timer_id;
+  }
+
+private:
+  // Four wheels of 256 slots, covering horizons of 256, 64k, 16M, and 4G
+  // ticks. Anything further out parks in the top wheel and re-cascades until
+  // it comes within range.
+  static constexpr uint64_t slot_bits = 8;
+  static constexpr uint64_t slots_per_wheel = uint64_t{1} << slot_bits;
+  static constexpr uint64_t slot_mask = slots_per_wheel - 1;
+  static constexpr size_t wheel_count = 4;
+  using slot_t = std::vector<scheduled_event>;
+  using wheel_t = std::array<slot_t, slots_per_wheel>;
+
+  // Callback to get the current time.
+  clock_callback_t clock_callback_ = [] {
+    return std::chrono::steady_clock::now();
+  };
+
+  // Width of one slot.
+  duration_t resolution_;
+
+  // Next timer ID to assign. May wrap around.
+  uint64_t next_timer_id_{};
+
+  // The last slot we processed, in ticks since the clock's epoch. Initialized
+  // from the first observed time, so that a test clock installed after
+  // construction is respected.
+  uint64_t current_tick_{};
+  bool started_{};
+
+  // As in `timers`, each event lives here until it won't fire again, and
+  // exactly one slot entry (or `ready_` entry) references it; a stale entry
+  // whose ID lookup or `next_at` check fails is harmlessly skipped.
+  timer_hash_map_t events_by_id_;
+  std::array<wheel_t, wheel_count> wheels_;
+
+  // Entries that came due but have not fired yet, drained from the front so
+  // that `max_callbacks` can stop partway without losing the rest.
+  slot_t ready_;
+  size_t ready_ndx_{};
+
+  uint64_t tick_of(time_point_t when) const {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<duration_t>(when.time_since_epoch()) /
+        resolution_);
+  }
+  time_point_t time_of(uint64_t tick) const {
+    return time_point_t{} +
+           std::chrono::duration_cast<time_point_t::duration>(
+               resolution_ * static_cast<int64_t>(tick));
+  }
+
+  void ensure_started() {
+    if (started_) return;
+    started_ = true;
+    current_tick_ = tick_of(get_now());
+  }
+
+  // File the entry in the innermost wheel whose span covers its delay. A due
+  // or past-due entry goes into the very next slot.
+  void schedule(const scheduled_event& entry) {
+    const auto when = std::max(tick_of(entry.next_at), current_tick_ + 1);
+    const auto delta = when - current_tick_;
+    for (size_t level = 0;; ++level) {
+      if (level == wheel_count - 1 ||
+          delta < (uint64_t{1} << (slot_bits * (level + 1)))) {
+        wheels_[level][(when >> (slot_bits * level)) & slot_mask].push_back(
+            entry);
+        return;
+      }
+    }
+  }
+
+  // Redistribute the current slot of an outer wheel into the wheels below it.
+  void cascade(size_t level) {
+    auto& slot =
+        wheels_[level][(current_tick_ >> (slot_bits * level)) & slot_mask];
+    auto entries = std::move(slot);
+    slot.clear();
+    for (const auto& entry : entries) {
+      if (tick_of(entry.next_at) <= current_tick_)
+        ready_.push_back(entry);
+      else
+        schedule(entry);
+    }
+  }
+
+  // Fire one due entry, with the same semantics as the body of
+  // `timers::tick`. Returns whether the callback was invoked.
+  bool fire(const scheduled_event& entry, time_point_t tick_now) {
+    // A stale entry, canceled or rescheduled, is a false alarm.
+    auto it = events_by_id_.find(entry.timer_id);
+    if (it == events_by_id_.end() || it->second.next_at != entry.next_at)
+      return false;
+
+    // If it expired, cancel it.
+    auto& event = it->second;
+    if (event.stop_at != time_point_t{} && event.stop_at <= tick_now) {
+      events_by_id_.erase(it);
+      return false;
+    }
+
+    const auto callback_now = get_now();
+    event.next_at = callback_now;
+    ++event.callbacks;
+    CORVID_INSTRUMENT_COUNT(timer_fires, 1);
+    event.callback(event);
+
+    // If the callback didn't reschedule, try to schedule the next time.
+    if (event.next_at == callback_now) {
+      if (event.repeat_in != duration_t{})
+        event.next_at = get_now() + event.repeat_in;
+      else
+        event.next_at = time_point_t{};
+    }
+    if (event.stop_at != time_point_t{} && event.stop_at <= event.next_at)
+      event.next_at = time_point_t{};
+
+    // If it's not scheduled, then there's no reason to keep it.
+    if (event.next_at <= callback_now) {
+      events_by_id_.erase(it);
+      return true;
+    }
+    event.next_at = coalesce(event.next_at, event.slack);
+    schedule({event.next_at, event.timer_id});
+    return true;
+  }
+};
+// Sharded timer engine.
+//
+// A single `timers` or `wheel_timers` serializes all scheduling: worker
+// threads must hand arm and cancel requests to the owning thread. This
+// wrapper runs one engine per shard (typically one per event-loop core),
+// each fed by a lock-free MPSC inbox, so any thread can schedule or cancel
+// on any shard while each owning thread processes its own expiries with no
+// shared state beyond the inbox handoff.
+//
+// The shard is chosen by the caller at `set` and is encoded in the low bits
+// of the returned `timer_id_t`, so `cancel` routes itself. The id is
+// assigned up front, before the owning thread has drained the request, and
+// is forced onto the engine at drain time, so engine ids and sharded ids
+// are one and the same.
+//
+// Each shard is single-threaded in the engine sense: only its owning thread
+// may call `tick`, `next_in`, `next_at`, `shard`, or `event` for it. Those
+// calls drain the inbox first, where applicable, so requests from other
+// threads are applied in arrival order before expiries are considered. A
+// full inbox fails the request rather than blocking; `set` then returns
+// `timer_id_t::invalid` and `cancel` returns false, and the caller may
+// retry after the owner next drains.
+template<typename ENGINE = timers, size_t SHARDS = 4>
+class sharded_timers {
+public:
+  static constexpr size_t shard_count = SHARDS;
+  static constexpr size_t inbox_capacity = 1024;
+  static_assert(SHARDS > 0);
+  static_assert(std::has_single_bit(inbox_capacity));
+
+  sharded_timers() = default;
+  sharded_timers(const sharded_timers&) = delete;
+  sharded_timers& operator=(const sharded_timers&) = delete;
+
+  // Which shard services this timer.
+  [[nodiscard]] static constexpr size_t shard_of(timer_id_t timer_id) {
+    return static_cast<size_t>(
+        static_cast<uint64_t>(timer_id) & ((uint64_t{1} << shard_bits) - 1));
+  }
+
+  // Set a timer for a new event on `shard`, from any thread. Returns the
+  // timer's id, or `timer_id_t::invalid` when the shard's inbox is full.
+  //
+  // Unlike the single-threaded engines, this cannot return the event, which
+  // does not exist until the owning thread drains the request; mutable
+  // fields like `user_data` must be set from the callback.
+  timer_id_t set(size_t shard, time_point_t start_at,
+      timer_callback_t callback, duration_t repeat_in = {},
+      time_point_t stop_at = {}, duration_t slack = {}) {
+    assert(shard < SHARDS);
+    const auto timer_id = next_id(shard);
+    if (!shards_[shard].inbox.try_emplace(message_kind::set, timer_id,
+            start_at, repeat_in, stop_at, slack, std::move(callback)))
+      return timer_id_t::invalid;
+    return timer_id;
+  }
+
+  timer_id_t set(size_t shard, duration_t start_in,
+      timer_callback_t callback, duration_t repeat_in = {},
+      duration_t stop_in = {}, duration_t slack = {}) {
+    const auto now = clock_callback_();
+    const auto stop_at =
+        (stop_in == duration_t{}) ? time_point_t{} : now + stop_in;
+    return set(shard, now + start_in, std::move(callback), repeat_in, stop_at,
+        slack);
+  }
+
+  // Cancel a timer, from any thread. Returns whether the request was
+  // enqueued; whether it finds the timer still alive is only determined
+  // when the owning thread drains it.
+  bool cancel(timer_id_t timer_id) {
+    if (timer_id == timer_id_t::invalid) return false;
+    return shards_[shard_of(timer_id)].inbox.try_emplace(
+        message_kind::cancel, timer_id);
+  }
+
+  // Service one shard, applying pending requests and then firing any timers
+  // that are ready, with the engine's `tick` semantics. Owning thread only.
+  size_t tick(size_t shard, size_t max_callbacks = size_t(-1)) {
+    drain(shard);
+    return shards_[shard].engine.tick(max_callbacks);
+  }
+
+  // Sleep bounds for one shard, with the engine's semantics. Owning thread
+  // only. Drains first, so a request armed by another thread shortens the
+  // reported sleep.
+  duration_t next_in(size_t shard, duration_t default_duration = {}) {
+    drain(shard);
+    return shards_[shard].engine.next_in(default_duration);
+  }
+  time_point_t next_at(size_t shard, time_point_t default_time = {}) {
+    drain(shard);
+    return shards_[shard].engine.next_at(default_time);
+  }
+
+  // The underlying engine for one shard. Owning thread only.
+  ENGINE& shard(size_t shard) { return shards_[shard].engine; }
+  timer_event& event(timer_id_t timer_id) {
+    return shards_[shard_of(timer_id)].engine.event(timer_id);
+  }
+
+  // For testing only.
+
+  // Takes the callable itself, not a `clock_callback_t`, because the
+  // wrapper is move-only and every engine needs its own copy.
+  template<typename CB>
+  void set_clock_callback(const CB& callback) {
+    for (auto& sh : shards_) sh.engine.set_clock_callback(callback);
+    clock_callback_ = callback;
+  }
+
+private:
+  static constexpr size_t shard_bits = std::bit_width(SHARDS - 1);
+
+  enum class message_kind : uint8_t { set, cancel };
+
+  // A cross-thread request, applied by the owning thread in arrival order.
+  struct message {
+    message_kind kind{};
+    timer_id_t timer_id{};
+    time_point_t start_at{};
+    duration_t repeat_in{};
+    time_point_t stop_at{};
+    duration_t slack{};
+    timer_callback_t callback{};
+  };
+  using inbox_t = mpsc_circular_buffer<message>;
+
+  // Padded apart so that one shard's engine does not share a cache line
+  // with another's inbox indexes.
+  struct alignas(64) shard_t {
+    std::vector<typename inbox_t::slot> inbox_slots{inbox_capacity};
+    inbox_t inbox{inbox_slots};
+    ENGINE engine;
+  };
+
+  // Mint a globally unique id carrying the shard in its low bits. The
+  // sequence starts at one, so the id can never collide with `invalid`.
+  timer_id_t next_id(size_t shard) {
+    const auto seq = next_seq_.fetch_add(1, std::memory_order_relaxed) + 1;
+    return timer_id_t{(seq << shard_bits) | shard};
+  }
+
+  // Apply pending requests. Forcing the engine's next id to the one minted
+  // at `set` keeps the public id and the engine id identical, so no mapping
+  // between the two is needed.
+  void drain(size_t shard) {
+    auto& sh = shards_[shard];
+    for (message m; sh.inbox.try_pop(m);) {
+      if (m.kind == message_kind::set) {
+        sh.engine.set_next_timer_id(static_cast<uint64_t>(m.timer_id) - 1);
+        sh.engine.set(m.start_at, std::move(m.callback), m.repeat_in,
+            m.stop_at, m.slack);
+      } else {
+        sh.engine.cancel(m.timer_id);
+      }
+    }
+  }
+
+  // Callback to get the current time, for the duration-based `set`. The
+  // engines hold their own copies.
+  clock_callback_t clock_callback_ = [] {
+    return std::chrono::steady_clock::now();
+  };
+
+  std::atomic<uint64_t> next_seq_{};
+  std::array<shard_t, SHARDS> shards_;
+};
 } // namespace timers_ns
 
 // Exported types.
 using timer_id_t = timers_ns::timer_id_t;
 using timers = timers_ns::timers;
+using wheel_timers = timers_ns::wheel_timers;
 using timer_event = timers_ns::timer_event;
+template<typename ENGINE = timers_ns::timers, size_t SHARDS = 4>
+using sharded_timers = timers_ns::sharded_timers<ENGINE, SHARDS>;
 
 }} // namespace corvid::container
 
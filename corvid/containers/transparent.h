@@ -52,6 +52,95 @@ struct transparent_hash_equal_stringlike {
   }
 };
 
+namespace details {
+
+// Fold a 64x64 multiply down to 64 bits, mixing high bits into low.
+constexpr uint64_t fold_mul(uint64_t a, uint64_t b) noexcept {
+#if defined(__SIZEOF_INT128__)
+  const auto m = static_cast<unsigned __int128>(a) * b;
+  return static_cast<uint64_t>(m) ^ static_cast<uint64_t>(m >> 64);
+#else
+  // Decompose into 32-bit halves when there's no 128-bit type.
+  const uint64_t lo_lo = (a & 0xffff'ffffull) * (b & 0xffff'ffffull);
+  const uint64_t hi_lo = (a >> 32) * (b & 0xffff'ffffull);
+  const uint64_t lo_hi = (a & 0xffff'ffffull) * (b >> 32);
+  const uint64_t hi_hi = (a >> 32) * (b >> 32);
+  const uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xffff'ffffull) + lo_hi;
+  const uint64_t hi = hi_hi + (hi_lo >> 32) + (cross >> 32);
+  const uint64_t lo = (cross << 32) | (lo_lo & 0xffff'ffffull);
+  return lo ^ hi;
+#endif
+}
+
+// Read up to 8 bytes, little-endian. Byte-at-a-time keeps it constexpr; at
+// runtime the compiler recognizes it as an unaligned load.
+constexpr uint64_t read_le(const char* p, size_t len) noexcept {
+  uint64_t v{};
+  for (size_t ndx = 0; ndx < len; ++ndx)
+    v |= static_cast<uint64_t>(static_cast<unsigned char>(p[ndx]))
+         << (8 * ndx);
+  return v;
+}
+
+} // namespace details
+
+// Default seed for `fast_hash`. Any value works; vary it per process or per
+// table for HashDoS resistance on externally controlled keys.
+inline constexpr uint64_t fast_hash_seed = 0xa076'1d64'78bd'642full;
+
+// Fast non-cryptographic string hash in the wyhash family: consumes 16 bytes
+// per multiply-fold, so short keys hash in a handful of instructions
+// regardless of which standard library is in play. Constexpr-capable, so
+// literals can hash at compile time.
+constexpr uint64_t
+fast_hash(std::string_view sv, uint64_t seed = fast_hash_seed) noexcept {
+  constexpr uint64_t k0 = 0xe703'7ed1'a0b4'28dbull;
+  constexpr uint64_t k1 = 0x8ebc'6af0'9c88'c6e3ull;
+  const auto* p = sv.data();
+  auto len = sv.size();
+  auto h = details::fold_mul(seed ^ k0, len ^ k1);
+  while (len >= 16) {
+    h = details::fold_mul(details::read_le(p, 8) ^ k0 ^ h,
+        details::read_le(p + 8, 8) ^ k1);
+    p += 16;
+    len -= 16;
+  }
+  if (len) {
+    const auto a = details::read_le(p, len < 8 ? len : 8);
+    const auto b = len > 8 ? details::read_le(p + 8, len - 8) : 0;
+    h = details::fold_mul(a ^ k0 ^ h, b ^ k1);
+  }
+  return details::fold_mul(h ^ sv.size(), k0);
+}
+
+// Drop-in replacement for `transparent_hash_equal_stringlike` that hashes
+// with `fast_hash` instead of `std::hash`. Stateless by default, but a seed
+// may be baked in through the template parameter or passed at construction
+// (and the instance handed to the container's constructor), for HashDoS
+// resistance on externally controlled keys.
+template<uint64_t SEED = fast_hash_seed>
+struct transparent_fast_hash_equal_stringlike {
+  using is_transparent = void;
+
+  constexpr transparent_fast_hash_equal_stringlike() noexcept = default;
+  constexpr explicit transparent_fast_hash_equal_stringlike(
+      uint64_t seed) noexcept
+      : seed_{seed} {}
+
+  template<typename T>
+  constexpr size_t operator()(const T& t) const {
+    return fast_hash(std::string_view{t}, seed_);
+  }
+
+  template<typename T, typename V>
+  constexpr bool operator()(const T& l, const V& r) const {
+    return static_cast<std::string_view>(l) ==
+           static_cast<std::string_view>(r);
+  }
+
+  uint64_t seed_{SEED};
+};
+
 // Map keyed by `std::string`, with transparent search.
 template<typename V = std::string,
     typename A = std::allocator<std::pair<const std::string, V>>>
@@ -79,4 +168,18 @@ using string_unordered_set = string_unordered_set_alloc<>;
 using string_unordered_set = std::unordered_set<std::string,
     transparent_hash_equal_stringlike, transparent_hash_equal_stringlike>;
 
+// As above, but hashed with `fast_hash`.
+template<typename V = std::string,
+    typename A = std::allocator<std::pair<const std::string, V>>>
+using fast_string_unordered_map = std::unordered_map<std::string, V,
+    transparent_fast_hash_equal_stringlike<>,
+    transparent_fast_hash_equal_stringlike<>, A>;
+
+template<typename A = std::allocator<std::string>>
+using fast_string_unordered_set_alloc = std::unordered_set<std::string,
+    transparent_fast_hash_equal_stringlike<>,
+    transparent_fast_hash_equal_stringlike<>, A>;
+
+using fast_string_unordered_set = fast_string_unordered_set_alloc<>;
+
 }} // namespace corvid::containers
@@ -15,6 +15,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 #pragma once
+#include <bit>
 #include "enums_shared.h"
 #include "../strings/lite.h"
 #include "../containers/opt_find.h"
@@ -371,6 +372,75 @@ template<BitmaskEnum E>
   return !has(v, m);
 }
 
+// Set-bit iteration
+
+// Number of bits set in `v`.
+template<BitmaskEnum E>
+[[nodiscard]] constexpr size_t flag_count(E v) noexcept {
+  using U = std::make_unsigned_t<std::underlying_type_t<E>>;
+  return static_cast<size_t>(std::popcount(static_cast<U>(*v)));
+}
+
+// Range over the set bits of a bitmask enum value, yielding each as an `E`
+// with that single bit set, from lsb to msb. Jumps directly between set bits
+// with `countr_zero`, so iteration costs one step per set bit, not one per
+// possible bit.
+template<BitmaskEnum E>
+class set_bits_view {
+  using U = std::make_unsigned_t<std::underlying_type_t<E>>;
+
+public:
+  class iterator {
+  public:
+    using value_type = E;
+    using difference_type = std::ptrdiff_t;
+    using iterator_category = std::forward_iterator_tag;
+
+    constexpr iterator() noexcept = default;
+    constexpr explicit iterator(U bits) noexcept : bits_{bits} {}
+
+    constexpr E operator*() const noexcept {
+      return E(U{1} << std::countr_zero(bits_));
+    }
+
+    constexpr iterator& operator++() noexcept {
+      bits_ &= bits_ - 1;
+      return *this;
+    }
+    constexpr iterator operator++(int) noexcept {
+      auto o = *this;
+      operator++();
+      return o;
+    }
+
+    constexpr bool operator==(const iterator&) const noexcept = default;
+
+  private:
+    U bits_{};
+  };
+
+  constexpr explicit set_bits_view(E v) noexcept
+      : bits_{static_cast<U>(*v)} {}
+
+  [[nodiscard]] constexpr auto begin() const noexcept {
+    return iterator{bits_};
+  }
+  [[nodiscard]] constexpr auto end() const noexcept { return iterator{}; }
+  [[nodiscard]] constexpr size_t size() const noexcept {
+    return static_cast<size_t>(std::popcount(bits_));
+  }
+  [[nodiscard]] constexpr bool empty() const noexcept { return !bits_; }
+
+private:
+  U bits_;
+};
+
+// Make a `set_bits_view` over the set bits of `v`.
+template<BitmaskEnum E>
+[[nodiscard]] constexpr auto set_bits(E v) noexcept {
+  return set_bits_view<E>{v};
+}
+
 namespace details {
 // Helper function to append bitmask to target, using bit names.
 template<ScopedEnum E, size_t N>
@@ -379,7 +449,7 @@ auto& do_bit_append(AppendTarget auto& target, E v,
   static constexpr strings::delim plus(" + ");
   bool first{true};
 
-  for (size_t ndx = N; ndx != 0; --ndx) {
+  for (size_t ndx = N; ndx != 0 && *v; --ndx) {
     auto mask = make_at<E>(ndx);
     auto ofs = N - ndx;
 
@@ -450,11 +520,42 @@ template<ScopedEnum E, wrapclip bitclip = wrapclip{}, E validbits = E{},
     std::size_t N = 0>
 struct bitmask_enum_names_spec
     : public bitmask_enum_spec<E, meta::as_underlying(validbits), bitclip> {
+  // For bit-named enums with few enough bits, every whole-mask rendering is
+  // precomputed at construction, so formatting a value is a table lookup and
+  // a single append instead of per-bit string building. Masks that would
+  // need a hex residual fall back to the assembly path.
+  static constexpr uint64_t cache_valid_bits_v =
+      static_cast<uint64_t>(meta::as_underlying(validbits));
+  static constexpr size_t cache_bit_count_v =
+      std::bit_width(cache_valid_bits_v);
+  static constexpr bool cache_renderings_v =
+      N != 0 && N == cache_bit_count_v && cache_bit_count_v <= 6;
+  static constexpr size_t cache_size_v =
+      cache_renderings_v ? (size_t{1} << cache_bit_count_v) : 1;
+  static constexpr size_t cache_len_cap_v = 64;
+
+  struct rendering {
+    std::array<char, cache_len_cap_v> text{};
+    uint8_t size{};
+    bool cached{};
+
+    [[nodiscard]] constexpr std::string_view view() const {
+      return {text.data(), size};
+    }
+  };
+
   constexpr bitmask_enum_names_spec(
       const std::array<std::string_view, N>& name_list)
-      : names(name_list) {}
+      : names(name_list), renderings(make_renderings(name_list)) {}
 
   auto& append(AppendTarget auto& target, E v) const {
+    if constexpr (cache_renderings_v) {
+      const auto u = static_cast<uint64_t>(meta::as_underlying(v));
+      if (u < renderings.size() && renderings[u].cached) {
+        strings::appender{target}.append(renderings[u].view());
+        return target;
+      }
+    }
     if constexpr (N == bits_length<E>())
       return details::do_bit_append(target, v, names);
     else if constexpr (N)
@@ -480,6 +581,38 @@ struct bitmask_enum_names_spec
   }
 
   const std::array<std::string_view, N> names;
+  const std::array<rendering, cache_size_v> renderings;
+
+private:
+  // Renders every mask by replaying the bit-append logic, leaving entries
+  // whose bits include an unnamed one, or whose text overflows the cap, to
+  // the runtime path.
+  static constexpr std::array<rendering, cache_size_v>
+  make_renderings(const std::array<std::string_view, N>& name_list) {
+    std::array<rendering, cache_size_v> result{};
+    if constexpr (cache_renderings_v) {
+      for (size_t mask = 0; mask != cache_size_v; ++mask) {
+        auto& r = result[mask];
+        const auto put = [&r](std::string_view part) {
+          if (r.size + part.size() > cache_len_cap_v) return false;
+          for (const char c : part) r.text[r.size++] = c;
+          return true;
+        };
+        bool ok = true, first = true;
+        for (size_t ndx = N; ndx != 0; --ndx) {
+          if (!(mask & (uint64_t{1} << (ndx - 1)))) continue;
+          const auto& name = name_list[N - ndx];
+          ok = !name.empty() && (first || put(" + ")) && put(name);
+          if (!ok) break;
+          first = false;
+        }
+        // Zero renders as padded hex; leave it to the runtime path.
+        if (first) ok = false;
+        r.cached = ok;
+      }
+    }
+    return result;
+  }
 };
 
 // Compile-time conversion of bit name array to valid bits. The names start
@@ -317,7 +317,7 @@ template<ScopedEnum E, E maxseq = E{}, E minseq = E{},
 struct sequence_enum_names_spec
     : public sequence_enum_spec<E, maxseq, minseq, wrapseq> {
   constexpr sequence_enum_names_spec(std::array<std::string_view, N> name_list)
-      : names(name_list) {}
+      : names(name_list), sorted_(sort_names(name_list)) {}
 
   auto& append(AppendTarget auto& target, E v) const {
     return do_seq_append(target, v, names);
@@ -330,13 +330,42 @@ struct sequence_enum_names_spec
         if (v != make<E>(*v)) return false;
       return true;
     }
-    auto found = std::find(names.begin(), names.end(), sv);
-    if (found == names.end()) return false;
-    v = make<E>(std::distance(names.begin(), found) + *min_value<E>());
+    // Binary search over the frozen index, comparing by length before
+    // content, so most probes are settled by the size check alone.
+    auto found = std::lower_bound(sorted_.begin(), sorted_.end(), sv,
+        [&](size_t ndx, std::string_view key) {
+          return name_less(names[ndx], key);
+        });
+    if (found == sorted_.end() || names[*found] != sv) return false;
+    v = make<E>(*found + *min_value<E>());
     return true;
   }
 
   const std::array<std::string_view, N> names;
+
+private:
+  // Orders names by length, then contents, so lookups can pre-filter on size.
+  static constexpr bool name_less(std::string_view l, std::string_view r) {
+    if (l.size() != r.size()) return l.size() < r.size();
+    return l < r;
+  }
+
+  // Index over `names`, frozen in sorted order at construction, which happens
+  // at compile time when the spec is a constexpr `enum_spec_v`. Ties go to
+  // the lower index, matching the old linear scan.
+  static constexpr std::array<size_t, N>
+  sort_names(const std::array<std::string_view, N>& name_list) {
+    std::array<size_t, N> ndx{};
+    for (size_t i = 0; i != N; ++i) ndx[i] = i;
+    std::sort(ndx.begin(), ndx.end(), [&](size_t l, size_t r) {
+      if (name_list[l] != name_list[r])
+        return name_less(name_list[l], name_list[r]);
+      return l < r;
+    });
+    return ndx;
+  }
+
+  const std::array<size_t, N> sorted_;
 };
 } // namespace details
 
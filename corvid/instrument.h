@@ -0,0 +1,223 @@
+// Corvid20: A general-purpose C++20 library extending std.
+// https://github.com/stevensudit/Corvid20
+//
+// Copyright 2022-2024 Steven Sudit
+//
+// Licensed under the Apache License, Version 2.0(the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#pragma once
+
+// Hot-path instrumentation: per-thread sharded counters and log-bucketed
+// histograms.
+//
+// Perf samples say where time goes but not what the code was doing; these
+// answer the domain questions (bytes allocated, intern hits versus misses,
+// timer fires) at a cost low enough to leave on in production. The hot path
+// is one relaxed increment on a cacheline private to the calling thread;
+// aggregation happens lazily, on read, by summing the shards.
+//
+// Like `CORVID_ARENA_STATS`, everything here is opt-in at compile time:
+// define `CORVID_INSTRUMENT` to enable it. When it's not defined, the hook
+// macros expand to nothing and none of the machinery below is even parsed,
+// so instrumented headers cost exactly nothing.
+
+#ifdef CORVID_INSTRUMENT
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <deque>
+#include <unordered_map>
+
+#include "containers/sync_lock.h"
+#include "strings/concat_join.h"
+
+namespace corvid {
+inline namespace instrument_ns {
+
+// Monotonic event counter, sharded per thread.
+//
+// Each thread lazily gets its own cacheline-aligned shard, so concurrent
+// increments never contend or bounce lines; `read` sums the shards, which
+// makes it a snapshot in the same sense as `use_count` on a shared pointer.
+// Counters are expected to live for the process (typically as the static
+// members of `metrics`), since threads hold bare pointers into them.
+class counter {
+public:
+  counter() = default;
+  counter(const counter&) = delete;
+  counter& operator=(const counter&) = delete;
+
+  // Hot path: one relaxed increment on this thread's shard. First touch by
+  // a new thread allocates the shard.
+  void add(uint64_t n = 1) {
+    local().fetch_add(n, std::memory_order_relaxed);
+  }
+
+  // Aggregate lazily, over all threads that ever touched the counter.
+  [[nodiscard]] uint64_t read() const {
+    lock l{sync_};
+    uint64_t total{};
+    for (auto& sh : shards_) total += sh.value.load(std::memory_order_relaxed);
+    return total;
+  }
+
+  auto& append_to(AppendTarget auto& target) const {
+    return strings::append(target, read());
+  }
+
+private:
+  struct alignas(64) shard_t {
+    std::atomic<uint64_t> value{};
+  };
+
+  // The calling thread's shard, created on first use.
+  std::atomic<uint64_t>& local() {
+    thread_local std::unordered_map<const counter*, shard_t*> slots;
+    auto& slot = slots[this];
+    if (!slot) {
+      lock l{sync_};
+      slot = &shards_.emplace_back();
+    }
+    return slot->value;
+  }
+
+  mutable synchronizer sync_;
+
+  // Deque for stable addresses.
+  std::deque<shard_t> shards_;
+};
+
+// Histogram over power-of-two buckets, sharded per thread like `counter`.
+//
+// `record` costs one `bit_width` and one relaxed increment; the value itself
+// is not stored, only which bucket it fell in. Bucket `b` covers
+// `[bucket_min(b), bucket_max(b)]`, which is `[2^(b-1), 2^b - 1]` except for
+// bucket 0, which holds exactly the zeroes. That is the usual tradeoff for
+// sizes and durations: fine resolution near zero, constant relative error
+// above.
+class histogram {
+public:
+  // One bucket per possible `bit_width`, 0 through 64.
+  static constexpr size_t bucket_count = 65;
+  using counts_t = std::array<uint64_t, bucket_count>;
+
+  histogram() = default;
+  histogram(const histogram&) = delete;
+  histogram& operator=(const histogram&) = delete;
+
+  [[nodiscard]] static constexpr size_t bucket_of(uint64_t v) noexcept {
+    return std::bit_width(v);
+  }
+  [[nodiscard]] static constexpr uint64_t bucket_min(size_t b) noexcept {
+    return b ? uint64_t{1} << (b - 1) : 0;
+  }
+  [[nodiscard]] static constexpr uint64_t bucket_max(size_t b) noexcept {
+    // Wraps to the full range for the top bucket.
+    return b ? (bucket_min(b) << 1) - 1 : 0;
+  }
+
+  // Hot path: bucket the value and bump this thread's shard.
+  void record(uint64_t v) {
+    local()[bucket_of(v)].fetch_add(1, std::memory_order_relaxed);
+  }
+
+  // Aggregate bucket counts, lazily, over all threads.
+  [[nodiscard]] counts_t counts() const {
+    lock l{sync_};
+    counts_t totals{};
+    for (auto& sh : shards_)
+      for (size_t b = 0; b < bucket_count; ++b)
+        totals[b] += sh.buckets[b].load(std::memory_order_relaxed);
+    return totals;
+  }
+
+  // Total number of recorded values.
+  [[nodiscard]] uint64_t count() const {
+    uint64_t total{};
+    for (auto c : counts()) total += c;
+    return total;
+  }
+
+  // Render the non-empty buckets as `{min-max: count, ...}`.
+  auto& append_to(AppendTarget auto& target) const {
+    const auto c = counts();
+    strings::append(target, '{');
+    std::string_view delim;
+    for (size_t b = 0; b < bucket_count; ++b) {
+      if (!c[b]) continue;
+      strings::append(target, delim, bucket_min(b), '-', bucket_max(b), ": ",
+          c[b]);
+      delim = ", ";
+    }
+    return strings::append(target, '}');
+  }
+
+private:
+  struct alignas(64) shard_t {
+    std::array<std::atomic<uint64_t>, bucket_count> buckets{};
+  };
+
+  // The calling thread's shard, created on first use.
+  std::array<std::atomic<uint64_t>, bucket_count>& local() {
+    thread_local std::unordered_map<const histogram*, shard_t*> slots;
+    auto& slot = slots[this];
+    if (!slot) {
+      lock l{sync_};
+      slot = &shards_.emplace_back();
+    }
+    return slot->buckets;
+  }
+
+  mutable synchronizer sync_;
+
+  // Deque for stable addresses.
+  std::deque<shard_t> shards_;
+};
+
+// The built-in metrics bumped by the hook points in `intern_table`, the
+// timer engines, and `extensible_arena`. Process-wide by design: the point
+// is a single place to read from, not per-instance accounting (the arena
+// already has `stats` for that).
+struct metrics {
+  static inline counter intern_hits;
+  static inline counter intern_misses;
+  static inline counter timer_fires;
+  static inline histogram arena_alloc_bytes;
+
+  // One `name: value` line per metric.
+  static auto& append_report(AppendTarget auto& target) {
+    strings::append(target, "intern_hits: ", intern_hits.read(), '\n');
+    strings::append(target, "intern_misses: ", intern_misses.read(), '\n');
+    strings::append(target, "timer_fires: ", timer_fires.read(), '\n');
+    strings::append(target, "arena_alloc_bytes: ");
+    arena_alloc_bytes.append_to(target);
+    return strings::append(target, '\n');
+  }
+};
+
+} // namespace instrument_ns
+} // namespace corvid
+
+// Hook points. Metric names resolve against the members of `metrics`.
+#define CORVID_INSTRUMENT_COUNT(metric, n) \
+  ::corvid::instrument_ns::metrics::metric.add(n)
+#define CORVID_INSTRUMENT_RECORD(metric, v) \
+  ::corvid::instrument_ns::metrics::metric.record(v)
+
+#else
+
+#define CORVID_INSTRUMENT_COUNT(metric, n) ((void)0)
+#define CORVID_INSTRUMENT_RECORD(metric, v) ((void)0)
+
+#endif
@@ -15,27 +15,45 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 #pragma once
+#include <cassert>
+#include <cstdint>
+#include <span>
 #include <string_view>
+#include <tuple>
 #include <variant>
 #include <vector>
 
+#include "../containers/arena_allocator.h"
 #include "../containers/transparent.h"
 #include "../enums/sequence_enum.h"
 #include "../strings.h"
 
 namespace corvid { inline namespace lang { namespace ast_pred {
 
+using namespace arena;
+
 // Predicate Abstract Syntax Tree (AST) and DNF transform.
+//
+// The entire tree, including child lists and string payloads, is allocated
+// from the `extensible_arena` in scope, so build (and convert) within an
+// `extensible_arena::scope`. Nodes are never individually destructed or
+// freed; the whole tree is released as a unit when its arena is reset or
+// destroyed.
 
-// Any single value for a key.
-using any_single_value = std::variant<std::monostate, std::string, int64_t>;
+// Any single value for a key. Strings live in the arena, like everything
+// else reachable from a node.
+using any_single_value = std::variant<std::monostate, arena_string, int64_t>;
+
+// List of single values.
+using any_value_list =
+    std::vector<any_single_value, arena_allocator<any_single_value>>;
 
 // Any value, included repeated ones.
-using any_value = std::variant<std::monostate, any_single_value,
-    std::vector<any_single_value>>;
+using any_value =
+    std::variant<std::monostate, any_single_value, any_value_list>;
 
 // Key for lookup, or a literal value.
-using key_or_value = std::variant<std::monostate, std::string, any_value>;
+using key_or_value = std::variant<std::monostate, arena_string, any_value>;
 
 // Operations for AST predicates.
 enum class operation {
@@ -76,11 +94,17 @@ namespace corvid { inline namespace lang { namespace ast_pred {
 // Returns `std::monostate` for missing keys.
 struct lookup {
   virtual ~lookup() = default;
-  virtual const any_value& operator[](const std::string& key) const;
+  virtual const any_value& operator[](const std::string& key) const {
+    (void)key;
+    return missing;
+  }
   static inline const any_value missing;
 };
 
 // Simple map-based lookup.
+//
+// The mapped values are arena-flavored, same as the AST, so populate within
+// an arena scope.
 struct map_lookup: public lookup {
   const any_value& operator[](const std::string& key) const override {
     const auto it = m.find(key);
@@ -93,26 +117,28 @@ struct map_lookup: public lookup {
 // Forward declaration of node.
 struct node;
 
-// Shared pointer to AST predicate root, internal, or leaf node.
-using node_ptr = std::shared_ptr<node>;
+// Pointer to AST predicate root, internal, or leaf node.
+//
+// The node is owned by the arena it was allocated from, not by the pointer,
+// so copies are free and the tree can share subtrees. Do not delete.
+using node_ptr = node*;
 
 // List of AST predicate nodes.
-using node_list = std::vector<node_ptr>;
+using node_list = std::vector<node_ptr, arena_allocator<node_ptr>>;
 
 // Concept for a type that is derived from `node`.
 template<typename T>
 concept node_type = std::derived_from<std::remove_cvref_t<T>, node>;
 
-// Concept for a shared_ptr to a T that is derived from `node`.
+// Concept for a pointer to a T that is derived from `node`.
 template<typename T>
-concept node_ptr_type =
-    std::is_same_v<std::shared_ptr<typename T::element_type>, T> &&
-    node_type<typename T::element_type>;
+concept node_ptr_type = std::is_pointer_v<std::remove_cvref_t<T>> &&
+                        node_type<std::remove_pointer_t<std::remove_cvref_t<T>>>;
 
 // AST predicate node.
 //
-// Construct using `make` factory function.
-struct node: public std::enable_shared_from_this<node> {
+// Construct using `make` factory function, within an arena scope.
+struct node {
 protected:
   enum class allow { ctor };
 
@@ -136,11 +162,11 @@ public:
   const operation op;
 
   template<operation op, typename... Args>
-  [[nodiscard]] static std::shared_ptr<node> make(Args&&... args);
+  [[nodiscard]] static node_ptr make(Args&&... args);
 
   static bool dump(std::string& out, const any_single_value& value) {
-    if (std::holds_alternative<std::string>(value))
-      strings::append(out, '"', std::get<std::string>(value), '"');
+    if (std::holds_alternative<arena_string>(value))
+      strings::append(out, '"', std::get<arena_string>(value), '"');
     else if (std::holds_alternative<int64_t>(value))
       strings::append_num(out, std::get<int64_t>(value));
     else
@@ -151,8 +177,8 @@ public:
   static bool dump(std::string& out, const any_value& value) {
     if (std::holds_alternative<any_single_value>(value))
       return dump(out, std::get<any_single_value>(value));
-    if (std::holds_alternative<std::vector<any_single_value>>(value)) {
-      const auto& values = std::get<std::vector<any_single_value>>(value);
+    if (std::holds_alternative<any_value_list>(value)) {
+      const auto& values = std::get<any_value_list>(value);
       strings::append(out, '[');
       for (const auto& v : values) {
         if (!dump(out, v)) return false;
@@ -167,8 +193,8 @@ public:
   }
 
   static bool dump(std::string& out, const key_or_value& value) {
-    if (std::holds_alternative<std::string>(value))
-      strings::append(out, std::get<std::string>(value));
+    if (std::holds_alternative<arena_string>(value))
+      strings::append(out, std::get<arena_string>(value));
     else if (std::holds_alternative<any_value>(value))
       return dump(out, std::get<any_value>(value));
     else
@@ -204,13 +230,13 @@ struct junction: public node {
 
   // Get the node list from a node pointer, downcasting it. Check `op` first.
   static const auto& list(const node_ptr& np) {
-    return static_cast<const junction*>(np.get())->nodes;
+    return static_cast<const junction*>(np)->nodes;
   }
 
   // Reference the node list from a node pointer, downcasting it. Check `op`
   // first.
   static auto& list(node_ptr& np) {
-    return static_cast<junction*>(np.get())->nodes;
+    return static_cast<junction*>(np)->nodes;
   }
 
   node_list nodes;
@@ -309,47 +335,83 @@ struct absent_node final: public unary_leaf {
 };
 
 template<operation op, typename... Args>
-std::shared_ptr<node> node::make(Args&&... args) {
+node_ptr node::make(Args&&... args) {
   if constexpr (op == operation::and_junction)
-    return std::make_shared<and_node>(allow::ctor,
-        std::forward<Args>(args)...);
+    return arena_new<and_node>(allow::ctor, std::forward<Args>(args)...);
   else if constexpr (op == operation::or_junction)
-    return std::make_shared<or_node>(allow::ctor, std::forward<Args>(args)...);
+    return arena_new<or_node>(allow::ctor, std::forward<Args>(args)...);
   else if constexpr (op == operation::not_junction)
-    return std::make_shared<not_node>(allow::ctor,
-        std::forward<Args>(args)...);
+    return arena_new<not_node>(allow::ctor, std::forward<Args>(args)...);
   else if constexpr (op == operation::always_false)
-    return std::make_shared<false_node>(allow::ctor);
+    return arena_new<false_node>(allow::ctor);
   else if constexpr (op == operation::always_true)
-    return std::make_shared<true_node>(allow::ctor);
+    return arena_new<true_node>(allow::ctor);
   else if constexpr (op == operation::eq)
-    return std::make_shared<eq_node>(allow::ctor, std::forward<Args>(args)...);
+    return arena_new<eq_node>(allow::ctor, std::forward<Args>(args)...);
   else if constexpr (op == operation::ne)
-    return std::make_shared<ne_node>(allow::ctor, std::forward<Args>(args)...);
+    return arena_new<ne_node>(allow::ctor, std::forward<Args>(args)...);
   else if constexpr (op == operation::exists)
-    return std::make_shared<exists_node>(allow::ctor,
-        std::forward<Args>(args)...);
+    return arena_new<exists_node>(allow::ctor, std::forward<Args>(args)...);
   else if constexpr (op == operation::absent)
-    return std::make_shared<absent_node>(allow::ctor,
-        std::forward<Args>(args)...);
+    return arena_new<absent_node>(allow::ctor, std::forward<Args>(args)...);
 }
 
+namespace details {
+
+// Copy a stringlike argument into the arena; pass anything else through.
+// This is what lets `make` callers hand over a `std::string`, a
+// `std::string_view`, or a literal for a `key_or_value` parameter.
+template<typename T>
+[[nodiscard]] decltype(auto) arena_arg(T&& t) {
+  if constexpr (StringViewConvertible<T>)
+    return arena_string{std::string_view{t}};
+  else
+    return std::forward<T>(t);
+}
+
+} // namespace details
+
 // Non-member wrapper; still type-safe because it takes `operation`.
 template<operation op, typename... Args>
 [[nodiscard]] node_ptr make(Args&&... args) {
-  return node::make<op>(std::forward<Args>(args)...);
+  return node::make<op>(details::arena_arg(std::forward<Args>(args))...);
 }
 
 // Disjunctive Normal Form (DNF) conversion.
 //
-// Performs some optimizations and simplifications.
+// Performs some optimizations and simplifications. Rebuilt nodes come from
+// the arena in scope, normally the same one the input tree came from.
+//
+// The transform hash-conses as it goes: structurally identical subtrees
+// (keyed by printed form) come out as the same node, and duplicate terms
+// within a junction collapse by idempotence. This keeps OR-over-AND
+// distribution from blowing up on pathological predicates that repeat the
+// same subexpressions.
 class dnf {
 public:
-  static node_ptr convert(const node_ptr& root) { return handle(root); }
+  static node_ptr convert(const node_ptr& root) { return dnf{}.handle(root); }
 
 private:
+  dnf() = default;
+
+  // Structurally identical nodes share one instance, keyed by printed form.
+  fast_string_unordered_map<node_ptr> interned_;
+
+  // Return the canonical instance of a structurally identical node.
+  node_ptr intern(const node_ptr& n) {
+    const auto [it, added] = interned_.try_emplace(n->print(), n);
+    return it->second;
+  }
+
+  // Append `n` unless already present. Children are interned, so pointer
+  // equality is structural equality.
+  static void push_unique(node_list& nodes, const node_ptr& n) {
+    if (std::find(nodes.begin(), nodes.end(), n) == nodes.end())
+      nodes.push_back(n);
+  }
+
   // Recursively rebuild subtree from this root down.
-  static node_ptr handle(const node_ptr& root) {
+  node_ptr handle(const node_ptr& root) {
     switch (root->op) {
     case operation::and_junction:
       return handle_conjunction(junction::list(root));
@@ -357,14 +419,16 @@ private:
       return handle_disjunction(junction::list(root));
     case operation::not_junction:
       return handle_negation(junction::list(root)[0]);
-    default: return root;
+    default: return intern(root);
     }
   }
 
-  static node_ptr handle_negation(const node_ptr& root) {
+  node_ptr handle_negation(const node_ptr& root) {
     switch (root->op) {
-    case operation::always_false: return make<operation::always_true>();
-    case operation::always_true: return make<operation::always_false>();
+    case operation::always_false:
+      return intern(make<operation::always_true>());
+    case operation::always_true:
+      return intern(make<operation::always_false>());
     // Nested NOTs cancel out.
     case operation::not_junction:
       return handle(junction::list(root).front());
@@ -372,39 +436,42 @@ private:
     case operation::and_junction: {
       node_list new_nodes;
       for (const auto& n : junction::list(root))
-        new_nodes.push_back(handle_negation(n));
-      return make<operation::or_junction>(std::move(new_nodes));
+        push_unique(new_nodes, handle_negation(n));
+      if (new_nodes.size() == 1) return new_nodes.front();
+      return intern(make<operation::or_junction>(std::move(new_nodes)));
     }
       // De Morgan's Law: NOT(A OR B) = NOT(A) AND NOT(B)
     case operation::or_junction: {
       node_list new_nodes;
-      for (const auto& n : junction::list(root)) {
-        new_nodes.push_back(handle_negation(n));
-      }
-      return make<operation::and_junction>(std::move(new_nodes));
+      for (const auto& n : junction::list(root))
+        push_unique(new_nodes, handle_negation(n));
+      if (new_nodes.size() == 1) return new_nodes.front();
+      return intern(make<operation::and_junction>(std::move(new_nodes)));
     }
       // NOT(A = B) = A != B
     case operation::eq: {
-      auto r = static_cast<const eq_node*>(root.get());
-      return make<operation::ne>(key_or_value{r->lhs}, key_or_value{r->rhs});
+      auto r = static_cast<const eq_node*>(root);
+      return intern(
+          make<operation::ne>(key_or_value{r->lhs}, key_or_value{r->rhs}));
     }
       // NOT(A != B) = A = B
     case operation::ne: {
-      auto r = static_cast<const ne_node*>(root.get());
-      return make<operation::eq>(key_or_value{r->lhs}, key_or_value{r->rhs});
+      auto r = static_cast<const ne_node*>(root);
+      return intern(
+          make<operation::eq>(key_or_value{r->lhs}, key_or_value{r->rhs}));
     }
     // NOT(EXISTS A) = ABSENT A
     case operation::exists: {
-      auto r = static_cast<const exists_node*>(root.get());
-      return make<operation::absent>(key_or_value{r->value});
+      auto r = static_cast<const exists_node*>(root);
+      return intern(make<operation::absent>(key_or_value{r->value}));
     }
     // NOT(ABSENT A) = EXISTS A
     case operation::absent: {
-      auto r = static_cast<const absent_node*>(root.get());
-      return make<operation::exists>(key_or_value{r->value});
+      auto r = static_cast<const absent_node*>(root);
+      return intern(make<operation::exists>(key_or_value{r->value}));
     }
     default: {
-      return make<operation::not_junction>(handle(root));
+      return intern(make<operation::not_junction>(handle(root)));
     }
     };
   }
@@ -414,7 +481,7 @@ private:
   // On input, `distribution` is a list of AND nodes (that will ultimately be
   // ORed together). Distributes `source_nodes` against these, returning a new
   // list of AND nodes, multiplied by the size of `source`.
-  static node_list distribute_or_values(const node_list& distribution,
+  node_list distribute_or_values(const node_list& distribution,
       const node_list& source_nodes) {
     node_list accumulated;
 
@@ -426,46 +493,46 @@ private:
           // Flatten nested ANDs.
           if (node->op == operation::and_junction) {
             for (const auto& inner_and_node : junction::list(node))
-              new_nodes.push_back(inner_and_node);
+              push_unique(new_nodes, inner_and_node);
           } else
-            new_nodes.push_back(node);
+            push_unique(new_nodes, node);
         }
-        new_nodes.push_back(or_child);
-        accumulated.push_back(
-            make<operation::and_junction>(std::move(new_nodes)));
+        push_unique(new_nodes, or_child);
+        push_unique(accumulated,
+            intern(make<operation::and_junction>(std::move(new_nodes))));
       }
     }
     return accumulated;
   }
 
   // Handle the children of an AND.
-  static node_ptr handle_conjunction(const node_list& nodes) {
+  node_ptr handle_conjunction(const node_list& nodes) {
     // Convert each node, splitting into a list of OR's and the rest.
     node_list converted_nodes, converted_or_nodes;
     for (const auto& n : nodes) {
-      auto converted = convert(n);
+      auto converted = handle(n);
       // An always-true node cannot contribute to the result.
       if (converted->op == operation::always_true) continue;
       // An always-false node will make the whole thing false.
       if (converted->op == operation::always_false)
-        return make<operation::always_false>();
+        return intern(make<operation::always_false>());
       // Target for special handling if an OR is found.
       if (converted->op == operation::or_junction) {
-        converted_or_nodes.push_back(std::move(converted));
+        push_unique(converted_or_nodes, converted);
         continue;
       }
       // Flatten nested ANDs.
       if (converted->op == operation::and_junction) {
         for (const auto& inner_and_node : junction::list(converted))
-          converted_nodes.push_back(inner_and_node);
+          push_unique(converted_nodes, inner_and_node);
         continue;
       }
-      converted_nodes.push_back(std::move(converted));
+      push_unique(converted_nodes, converted);
     }
 
     // If no nodes, then the result is always true.
     if (converted_nodes.empty() && converted_or_nodes.empty())
-      return make<operation::always_true>();
+      return intern(make<operation::always_true>());
 
     // If just one, then use that.
     if (converted_nodes.size() == 1 && converted_or_nodes.size() == 0)
@@ -476,14 +543,14 @@ private:
     // If no OR nodes to distribute, just recreate the AND node with the
     // converted children.
     if (converted_or_nodes.empty())
-      return make<operation::and_junction>(std::move(converted_nodes));
+      return intern(make<operation::and_junction>(std::move(converted_nodes)));
 
     // Distribute OR over AND
     // Start with a single AND node with all of the non-OR nodes. This will be
     // multiplied by the children of the OR nodes.
     node_list accumulated;
     accumulated.push_back(
-        make<operation::and_junction>(std::move(converted_nodes)));
+        intern(make<operation::and_junction>(std::move(converted_nodes))));
 
     // Distribute the OR nodes over the other nodes, iteratively.
     for (const auto& converted_or_node : converted_or_nodes) {
@@ -491,38 +558,399 @@ private:
           distribute_or_values(accumulated, junction::list(converted_or_node));
     }
 
-    return make<operation::or_junction>(std::move(accumulated));
+    if (accumulated.size() == 1) return accumulated.front();
+    return intern(make<operation::or_junction>(std::move(accumulated)));
   }
 
   // Handle the children of an OR.
-  static node_ptr handle_disjunction(const node_list& nodes) {
+  node_ptr handle_disjunction(const node_list& nodes) {
     // Build converted list, scanning for the types created.
     node_list converted_nodes;
     for (const auto& n : nodes) {
-      auto converted = convert(n);
+      auto converted = handle(n);
       // An always-false node cannot contribute to the result.
       if (converted->op == operation::always_false) continue;
       // An always-true node will make the whole thing true.
       if (converted->op == operation::always_true)
-        return make<operation::always_true>();
+        return intern(make<operation::always_true>());
       // Flatten nested ORs.
       if (converted->op == operation::or_junction) {
         for (const auto& child : junction::list(converted))
-          converted_nodes.push_back(child);
+          push_unique(converted_nodes, child);
       } else
-        converted_nodes.push_back(std::move(converted));
+        push_unique(converted_nodes, converted);
     }
 
     // If no nodes, then the result is always false.
-    if (converted_nodes.empty()) return make<operation::always_false>();
+    if (converted_nodes.empty())
+      return intern(make<operation::always_false>());
     // If just one, then use that.
     if (converted_nodes.size() == 1) return converted_nodes.front();
 
     // Don't distribute these terms because that would move us towards CNF, not
     // DNF.
-    return make<operation::or_junction>(std::move(converted_nodes));
+    return intern(make<operation::or_junction>(std::move(converted_nodes)));
+  }
+};
+
+// Flattened, evaluation-ready form of a DNF predicate.
+//
+// `compile` walks a tree (normally the output of `dnf::convert`) once and
+// emits flat arrays: a pool of distinct tests, with keys resolved to
+// indexes and constants pooled, plus the list of AND clauses referencing
+// them. Repeated evaluation then runs a tight switch over cache-resident
+// buffers instead of chasing the node forest, and a test repeated across
+// clauses is evaluated once per record.
+//
+// The program owns plain copies of everything it references, so it is fully
+// self-contained: it outlives the tree and the arena the tree came from, and
+// needs no arena in scope to evaluate.
+class program {
+public:
+  // Pooled constant: a plain mirror of `any_value`, so that the program does
+  // not pin any arena.
+  using flat_single = std::variant<std::monostate, std::string, int64_t>;
+  using flat_value =
+      std::variant<std::monostate, flat_single, std::vector<flat_single>>;
+
+  // Where a test operand comes from.
+  enum class operand : uint8_t { none, key, constant };
+
+  // One test: applies `op` to its resolved operands. Tests are pooled, so
+  // a term repeated across clauses is stored (and evaluated) once.
+  struct instruction {
+    operation op{};
+    operand lhs_kind{};
+    operand rhs_kind{};
+    uint16_t lhs{};
+    uint16_t rhs{};
+
+    bool operator==(const instruction&) const = default;
+  };
+
+  // Compile `root` into a program. Leaf operations without evaluation
+  // semantics (such as `lt` or `matches`) compile into tests that always
+  // fail, mirroring the `node::eval` default.
+  [[nodiscard]] static program compile(const node_ptr& root) {
+    program p;
+    if (root->op == operation::or_junction)
+      for (const auto& n : junction::list(root)) p.add_clause(n);
+    else
+      p.add_clause(root);
+    return p;
+  }
+
+  // Distinct keys the program tests, in first-use order. Resolve these
+  // against the record once, then `eval` any number of times.
+  [[nodiscard]] std::span<const std::string> keys() const { return keys_; }
+
+  // Distinct tests after pooling; a lower count than the tree's leaf count
+  // shows how much deduplication bought.
+  [[nodiscard]] size_t test_count() const { return tests_.size(); }
+
+  // Evaluate against pre-resolved values: `values[i]` is the record's value
+  // for `keys()[i]`, with `nullptr` (or monostate) meaning missing. Each
+  // distinct test is evaluated at most once per record, no matter how many
+  // clauses repeat it.
+  [[nodiscard]] bool eval(std::span<const any_value* const> values) const {
+    assert(values.size() == keys_.size());
+    std::vector<int8_t> memo(tests_.size(), int8_t{-1});
+    for (const auto& c : clauses_) {
+      bool ok = true;
+      for (size_t ndx = c.first; ok && ndx < c.first + c.count; ++ndx) {
+        auto& m = memo[clause_tests_[ndx]];
+        if (m < 0) m = test(tests_[clause_tests_[ndx]], values) ? 1 : 0;
+        ok = m > 0;
+      }
+      if (ok) return true;
+    }
+    return false;
+  }
+
+  // Convenience: evaluate through a `lookup`, resolving every key. Callers
+  // on a hot path should resolve once and use the span overload.
+  [[nodiscard]] bool eval(const lookup& lk) const {
+    std::vector<const any_value*> values;
+    values.reserve(keys_.size());
+    for (const auto& k : keys_) values.push_back(&lk[k]);
+    return eval(values);
+  }
+
+  // One column of record values for a key: `column[row]` is that row's
+  // value, with `nullptr` (or monostate) meaning missing.
+  using value_column = std::span<const any_value* const>;
+
+  // Words needed for a selection bitmap over `rows` records.
+  [[nodiscard]] static constexpr size_t bitmap_words(size_t rows) {
+    return (rows + 63) / 64;
+  }
+
+  // Columnar batch evaluation: apply the program to `rows` records at once,
+  // setting bit `r` of `out` when record `r` matches. `columns[i]` holds the
+  // values for `keys()[i]`, one per record. Each test runs as one tight loop
+  // over its column, producing a bitmap, and clauses combine bitmaps with
+  // word-wide AND/OR, so the filter stage does a handful of linear passes
+  // instead of per-row dispatch.
+  void eval_batch(size_t rows, std::span<const value_column> columns,
+      std::span<uint64_t> out) const {
+    assert(columns.size() == keys_.size());
+    for ([[maybe_unused]] const auto& column : columns)
+      assert(column.size() == rows);
+    const auto words = bitmap_words(rows);
+    assert(out.size() >= words);
+    std::fill_n(out.begin(), words, uint64_t{});
+    // All-ones, with the bits past the last row masked off.
+    const auto last_mask =
+        rows % 64 ? (uint64_t{1} << (rows % 64)) - 1 : ~uint64_t{};
+    // Each distinct test's bitmap is computed once, shared across clauses.
+    std::vector<std::vector<uint64_t>> tested(tests_.size());
+    for (size_t t = 0; t < tests_.size(); ++t) {
+      tested[t].resize(words);
+      test_batch(tests_[t], rows, columns, tested[t]);
+    }
+    std::vector<uint64_t> clause(words);
+    for (const auto& c : clauses_) {
+      std::fill(clause.begin(), clause.end(), ~uint64_t{});
+      if (words) clause[words - 1] = last_mask;
+      for (size_t ndx = c.first; ndx < c.first + c.count; ++ndx) {
+        const auto& bm = tested[clause_tests_[ndx]];
+        for (size_t w = 0; w < words; ++w) clause[w] &= bm[w];
+      }
+      for (size_t w = 0; w < words; ++w) out[w] |= clause[w];
+    }
+  }
+
+private:
+  program() = default;
+
+  // One AND clause: a run of test indexes in `clause_tests_`.
+  struct clause_t {
+    uint16_t first{};
+    uint16_t count{};
+  };
+
+  // Append one AND clause.
+  void add_clause(const node_ptr& n) {
+    clause_t c{narrow(clause_tests_.size()), 0};
+    if (n->op == operation::and_junction)
+      for (const auto& child : junction::list(n)) add_test(c, child);
+    else
+      add_test(c, n);
+    c.count = static_cast<uint16_t>(clause_tests_.size() - c.first);
+    clauses_.push_back(c);
+  }
+
+  // Append one test to the clause being built, pooling duplicates. An
+  // always-true node contributes nothing; everything else, including
+  // unsupported operations, gets an instruction.
+  void add_test(const clause_t& c, const node_ptr& n) {
+    if (n->op == operation::always_true) return;
+    instruction inst{n->op};
+    switch (n->op) {
+    case operation::exists:
+    case operation::absent: {
+      const auto* leaf = static_cast<const unary_leaf*>(n);
+      std::tie(inst.lhs_kind, inst.lhs) = add_operand(leaf->value);
+      break;
+    }
+    case operation::eq:
+    case operation::ne: {
+      const auto* leaf = static_cast<const binary_leaf*>(n);
+      std::tie(inst.lhs_kind, inst.lhs) = add_operand(leaf->lhs);
+      std::tie(inst.rhs_kind, inst.rhs) = add_operand(leaf->rhs);
+      break;
+    }
+    default: break;
+    }
+    auto it = std::find(tests_.begin(), tests_.end(), inst);
+    if (it == tests_.end()) it = tests_.insert(tests_.end(), inst);
+    const auto t = narrow(it - tests_.begin());
+    // Idempotence: skip a test this clause already performs.
+    const auto begin = clause_tests_.begin() + c.first;
+    if (std::find(begin, clause_tests_.end(), t) == clause_tests_.end())
+      clause_tests_.push_back(t);
   }
+
+  // Resolve a `key_or_value` into an operand: strings name keys, which are
+  // deduplicated into the key table, and literal values are pooled.
+  std::pair<operand, uint16_t> add_operand(const key_or_value& value) {
+    if (std::holds_alternative<arena_string>(value)) {
+      const std::string_view sv = std::get<arena_string>(value);
+      auto it = std::find(keys_.begin(), keys_.end(), sv);
+      if (it == keys_.end()) it = keys_.insert(keys_.end(), std::string{sv});
+      return {operand::key, narrow(it - keys_.begin())};
+    }
+    if (std::holds_alternative<any_value>(value)) {
+      auto v = flatten(std::get<any_value>(value));
+      auto it = std::find(constants_.begin(), constants_.end(), v);
+      if (it == constants_.end())
+        it = constants_.insert(constants_.end(), std::move(v));
+      return {operand::constant, narrow(it - constants_.begin())};
+    }
+    return {operand::none, 0};
+  }
+
+  static uint16_t narrow(ptrdiff_t ndx) {
+    assert(ndx <= UINT16_MAX);
+    return static_cast<uint16_t>(ndx);
+  }
+
+  // Copy an arena-flavored value into its plain mirror.
+  static flat_single flatten(const any_single_value& v) {
+    if (std::holds_alternative<arena_string>(v))
+      return std::string{std::string_view{std::get<arena_string>(v)}};
+    if (std::holds_alternative<int64_t>(v)) return std::get<int64_t>(v);
+    return {};
+  }
+
+  static flat_value flatten(const any_value& v) {
+    if (std::holds_alternative<any_single_value>(v))
+      return flatten(std::get<any_single_value>(v));
+    if (std::holds_alternative<any_value_list>(v)) {
+      std::vector<flat_single> values;
+      for (const auto& e : std::get<any_value_list>(v))
+        values.push_back(flatten(e));
+      return values;
+    }
+    return {};
+  }
+
+  // Compare an arena-flavored value against its plain mirror. The variants
+  // have the same alternatives in the same order, so indexes line up.
+  static bool equal(const any_single_value& l, const flat_single& r) {
+    if (l.index() != r.index()) return false;
+    if (std::holds_alternative<arena_string>(l))
+      return std::string_view{std::get<arena_string>(l)} ==
+             std::get<std::string>(r);
+    if (std::holds_alternative<int64_t>(l))
+      return std::get<int64_t>(l) == std::get<int64_t>(r);
+    return true;
+  }
+
+  static bool equal(const any_value& l, const flat_value& r) {
+    if (l.index() != r.index()) return false;
+    if (std::holds_alternative<any_single_value>(l))
+      return equal(std::get<any_single_value>(l), std::get<flat_single>(r));
+    if (std::holds_alternative<any_value_list>(l)) {
+      const auto& lv = std::get<any_value_list>(l);
+      const auto& rv = std::get<std::vector<flat_single>>(r);
+      if (lv.size() != rv.size()) return false;
+      for (size_t ndx = 0; ndx < lv.size(); ++ndx)
+        if (!equal(lv[ndx], rv[ndx])) return false;
+      return true;
+    }
+    return true;
+  }
+
+  // A resolved operand: a record value, a pooled constant, or neither.
+  struct resolved {
+    const any_value* rec{};
+    const flat_value* con{};
+
+    [[nodiscard]] bool present() const {
+      if (rec) return !std::holds_alternative<std::monostate>(*rec);
+      if (con) return !std::holds_alternative<std::monostate>(*con);
+      return false;
+    }
+  };
+
+  resolved resolve(operand kind, uint16_t ndx,
+      std::span<const any_value* const> values) const {
+    switch (kind) {
+    case operand::key: return {values[ndx], nullptr};
+    case operand::constant: return {nullptr, &constants_[ndx]};
+    default: return {};
+    }
+  }
+
+  static bool equal(const resolved& l, const resolved& r) {
+    if (l.rec && r.rec) return *l.rec == *r.rec;
+    if (l.rec && r.con) return equal(*l.rec, *r.con);
+    if (l.con && r.rec) return equal(*r.rec, *l.con);
+    if (l.con && r.con) return *l.con == *r.con;
+    return false;
+  }
+
+  bool test(const instruction& inst,
+      std::span<const any_value* const> values) const {
+    const auto lhs = resolve(inst.lhs_kind, inst.lhs, values);
+    switch (inst.op) {
+    case operation::exists: return lhs.present();
+    case operation::absent: return !lhs.present();
+    case operation::eq:
+    case operation::ne: {
+      const auto rhs = resolve(inst.rhs_kind, inst.rhs, values);
+      if (!lhs.present() || !rhs.present()) return false;
+      return equal(lhs, rhs) == (inst.op == operation::eq);
+    }
+    default: return false;
+    }
+  }
+
+  // Fill a bitmap from a per-row predicate, building each word in a
+  // register before storing it.
+  template<typename PRED>
+  static void
+  fill_bitmap(size_t rows, std::span<uint64_t> out, PRED&& pred) {
+    for (size_t w = 0, r = 0; r < rows; ++w) {
+      uint64_t word{};
+      for (size_t b = 0; b < 64 && r < rows; ++b, ++r)
+        word |= uint64_t{pred(r)} << b;
+      out[w] = word;
+    }
+  }
+
+  // Evaluate one test across the whole batch into `out`. Constant operands
+  // are resolved once, outside the row loop.
+  void test_batch(const instruction& inst, size_t rows,
+      std::span<const value_column> columns, std::span<uint64_t> out) const {
+    const auto fixed = [this](operand kind, uint16_t ndx) {
+      return kind == operand::constant ? resolved{nullptr, &constants_[ndx]}
+                                       : resolved{};
+    };
+    const auto* lcol =
+        inst.lhs_kind == operand::key ? &columns[inst.lhs] : nullptr;
+    const auto* rcol =
+        inst.rhs_kind == operand::key ? &columns[inst.rhs] : nullptr;
+    const auto lfix = fixed(inst.lhs_kind, inst.lhs);
+    const auto rfix = fixed(inst.rhs_kind, inst.rhs);
+    const auto lhs_at = [&](size_t r) {
+      return lcol ? resolved{(*lcol)[r], nullptr} : lfix;
+    };
+    const auto rhs_at = [&](size_t r) {
+      return rcol ? resolved{(*rcol)[r], nullptr} : rfix;
+    };
+    switch (inst.op) {
+    case operation::exists:
+      fill_bitmap(rows, out, [&](size_t r) { return lhs_at(r).present(); });
+      break;
+    case operation::absent:
+      fill_bitmap(rows, out, [&](size_t r) { return !lhs_at(r).present(); });
+      break;
+    case operation::eq:
+    case operation::ne: {
+      const bool want = inst.op == operation::eq;
+      fill_bitmap(rows, out, [&](size_t r) {
+        const auto lhs = lhs_at(r);
+        const auto rhs = rhs_at(r);
+        if (!lhs.present() || !rhs.present()) return false;
+        return equal(lhs, rhs) == want;
+      });
+      break;
+    }
+    default:
+      fill_bitmap(rows, out, [](size_t) { return false; });
+      break;
+    }
+  }
+
+  std::vector<std::string> keys_;
+  std::vector<flat_value> constants_;
+  std::vector<instruction> tests_;
+  std::vector<uint16_t> clause_tests_;
+  std::vector<clause_t> clauses_;
 };
+
 }}} // namespace corvid::lang::ast_pred
 
 // TODO: Properly register the variants so that they can be printed as JSON
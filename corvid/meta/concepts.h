@@ -39,9 +39,16 @@ concept OStreamable = requires(T t, std::ostream& os) { os << t; };
 template<typename T>
 concept StdString = SameAs<std::string, T>;
 
+// `T` must declare itself as a dedicated append target by exposing an
+// `is_append_target_t` member type and providing `append` overloads for
+// `std::string_view` and repeated characters.
+template<typename T>
+concept DedicatedAppendTarget = requires { typename T::is_append_target_t; };
+
 // `T` must be a target to append to.
 template<typename T>
-concept AppendTarget = OStreamDerived<T> || StdString<T>;
+concept AppendTarget =
+    OStreamDerived<T> || StdString<T> || DedicatedAppendTarget<T>;
 
 // `T` must be an enum, which could be scoped or not.
 template<typename T>
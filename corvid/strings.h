@@ -17,6 +17,7 @@
 #pragma once
 #include "strings/strings_shared.h"
 #include "strings/cstring_view.h"
+#include "strings/shared_cstring.h"
 #include "strings/fixed_string.h"
 #include "strings/fixed_string_utils.h"
 #include "strings/cases.h"
@@ -15,6 +15,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 #pragma once
+#include "locating.h"
 #include "strings_shared.h"
 
 namespace corvid::strings { inline namespace cases {
@@ -23,18 +24,53 @@ namespace corvid::strings { inline namespace cases {
 // Case change.
 //
 
+namespace details {
+
+// Word with 0x20 set in each lane of `word` holding a byte in [first, last],
+// which must be a range of seven-bit values. Since 0x20 is precisely the
+// ASCII case bit, XORing the result back in flips the case of every letter
+// in the word at once.
+[[nodiscard]] constexpr std::uint64_t swar_case_bits(std::uint64_t word,
+    char first, char last) noexcept {
+  using namespace locating::details;
+  const auto seven = word & ~swar_highs;
+  const auto ge_first =
+      seven + (0x80 - static_cast<unsigned char>(first)) * swar_ones;
+  const auto gt_last =
+      seven + (0x7F - static_cast<unsigned char>(last)) * swar_ones;
+  return ((ge_first & ~gt_last & ~word) & swar_highs) >> 2;
+}
+
+// Flip the case bit of every byte of `s` in [first, last], eight bytes at a
+// time, falling back to one byte at a time for the tail.
+inline void flip_case_bits(char* data, size_t size, char first,
+    char last) noexcept {
+  using namespace locating::details;
+  size_t pos = 0;
+  for (; pos + 8 <= size; pos += 8) {
+    auto word = swar_load(data + pos);
+    word ^= swar_case_bits(word, first, last);
+    std::memcpy(data + pos, &word, sizeof(word));
+  }
+  for (; pos < size; ++pos)
+    if (data[pos] >= first && data[pos] <= last) data[pos] ^= 0x20;
+}
+
+} // namespace details
+
 // Convert to uppercase.
 // Avoids `std::toupper` because it's locale-dependent and slow.
 [[nodiscard]] inline char to_upper(char c) {
   return (c >= 'a' && c <= 'z') ? c - ('a' - 'A') : c;
 }
 
-// Convert to uppercase.
+// Convert to uppercase, a word at a time. Like the `char` overload, this is
+// deliberately ASCII-only, not locale-aware.
 inline void to_upper(Range auto& r) {
   std::span s{r};
-  std::ranges::transform(s, s.begin(), [](unsigned char c) {
-    return toupper(c);
-  });
+  static_assert(sizeof(*s.data()) == 1);
+  details::flip_case_bits(reinterpret_cast<char*>(s.data()), s.size(), 'a',
+      'z');
 }
 
 // Return as uppercase.
@@ -50,12 +86,13 @@ inline void to_upper(Range auto& r) {
   return (c >= 'A' && c <= 'Z') ? c + ('a' - 'A') : c;
 }
 
-// Convert to lowercase.
+// Convert to lowercase, a word at a time. Like the `char` overload, this is
+// deliberately ASCII-only, not locale-aware.
 inline void to_lower(Range auto& r) {
   std::span s{r};
-  std::ranges::transform(s, s.begin(), [](unsigned char c) {
-    return tolower(c);
-  });
+  static_assert(sizeof(*s.data()) == 1);
+  details::flip_case_bits(reinterpret_cast<char*>(s.data()), s.size(), 'A',
+      'Z');
 }
 
 // Return as lowercase.
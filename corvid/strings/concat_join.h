@@ -152,6 +152,50 @@ inline namespace appending {
 // If the class can already stream out to `std::ostream`, you can support it
 // for append just by enabling `stream_append_v`.
 
+// Estimate the number of characters that appending a piece will produce, for
+// the purpose of reserving target capacity up front. Strings are counted
+// exactly, numbers with a tight upper bound, and containers and tuples
+// recurse over their elements. Parts we can't size cheaply (streamed or
+// overridden appenders) contribute a small flat guess, so the total is a
+// decent floor, not a ceiling.
+template<typename T>
+[[nodiscard]] constexpr size_t estimated_size(const T& part) {
+  if constexpr (StringViewConvertible<T> && Appendable<T>)
+    return is_present(part) ? std::string_view{part}.size() : 4;
+  else if constexpr (NullPtr<T> || MonoState<T>)
+    return 4;
+  else if constexpr (Char<T>)
+    return 1;
+  else if constexpr (Bool<T>)
+    return 5;
+  else if constexpr (std::is_integral_v<T>)
+    return std::numeric_limits<T>::digits10 + 2;
+  else if constexpr (std::is_floating_point_v<T>)
+    return 24;
+  else if constexpr (StdEnum<T>)
+    return 16;
+  else if constexpr (VoidPointer<T>)
+    return sizeof(uintptr_t) * 2 + 2;
+  else if constexpr (Variant<T> && Appendable<T>) {
+    if (part.valueless_by_exception()) return 4;
+    return std::visit(
+        [](const auto& inside) { return estimated_size(inside); }, part);
+  } else if constexpr (OptionalLike<T> && Appendable<T>)
+    return part ? estimated_size(*part) : 4;
+  else if constexpr (TupleLike<T> && Appendable<T>)
+    return std::apply(
+        [](const auto&... parts) {
+          return (size_t{} + ... + estimated_size(parts));
+        },
+        part);
+  else if constexpr (Container<T> && Appendable<T>) {
+    size_t total = 2;
+    for (auto& p : part) total += estimated_size(p) + 2;
+    return total;
+  } else
+    return 8;
+}
+
 // Append one stringlike thing to `target`. If it's not present, append "null".
 template<StringViewConvertible T>
 requires Appendable<T>
@@ -283,6 +327,7 @@ constexpr auto& append(A& target, const T& part) {
 // `join` and `join_with` for delimiter support.
 [[nodiscard]] constexpr auto concat(const auto& head, const auto&... tail) {
   std::string target;
+  target.reserve((estimated_size(head) + ... + estimated_size(tail)));
   return append(target, head, tail...);
 }
 
@@ -639,6 +684,12 @@ append_join_with(AppendTarget auto& target, delim d, const T& parts) {
 }
 
 namespace details {
+// Size floor for joining the pieces with `d`, counting a delimiter plus a
+// little slack for braces and quotes per piece.
+constexpr size_t estimated_join_size(delim d, const auto&... parts) {
+  return (size_t{2} + ... + (estimated_size(parts) + d.size() + 2));
+}
+
 // Helper for `append_join_with` parameter pack overload.
 template<join_opt opt, char open = 0, char close = 0, typename Head,
     typename... Tail>
@@ -689,6 +740,7 @@ template<auto opt = join_opt::braced, char open = 0, char close = 0>
 [[nodiscard]] constexpr auto
 join_with(delim d, const auto& head, const auto&... tail) {
   std::string target;
+  target.reserve(details::estimated_join_size(d, head, tail...));
   return append_join_with<opt, open, close>(target, d, head, tail...);
 }
 
@@ -696,6 +748,7 @@ join_with(delim d, const auto& head, const auto&... tail) {
 template<auto opt = join_opt::braced, char open = 0, char close = 0>
 [[nodiscard]] constexpr auto join(const auto& head, const auto&... tail) {
   std::string target;
+  target.reserve(details::estimated_join_size(delim{", "sv}, head, tail...));
   return append_join_with<opt, open, close>(target, delim{", "sv}, head,
       tail...);
 }
@@ -710,10 +763,58 @@ append_json(AppendTarget auto& target, const auto& head, const auto&... tail) {
 // Join pieces together into `std::string` as JSON.
 [[nodiscard]] constexpr auto join_json(const auto& head, const auto&... tail) {
   std::string target;
+  target.reserve(details::estimated_join_size(delim{", "sv}, head, tail...));
   return append_join_with<join_opt::json>(target, delim{", "sv}, head,
       tail...);
 }
 
+//
+// Buffered streaming
+//
+
+// While a `std::ostream` is itself an `AppendTarget`, appending a composed
+// record to one costs a virtual write per piece. The `buffered_out` family
+// formats into a reusable thread-local buffer instead and hands the whole
+// record to the stream with a single `sputn`, so streaming a joined record
+// to a log ostream performs no heap allocations after warmup and copies each
+// piece exactly once. See `streaming.h` for the `operator<<` equivalents.
+
+namespace details {
+
+// Thread-local format buffer shared by the `buffered_out` family. Treated as
+// a stack, which keeps reentrant use safe.
+inline std::string& stream_buffer() {
+  static thread_local std::string buffer;
+  return buffer;
+}
+
+} // namespace details
+
+// Stream pieces to `os` through the `append` machinery, without delimiters.
+auto& buffered_out(OStreamDerived auto& os, const auto&... parts) {
+  auto& b = details::stream_buffer();
+  const auto start = b.size();
+  append(b, parts...);
+  os.rdbuf()->sputn(b.data() + start,
+      static_cast<std::streamsize>(b.size() - start));
+  b.resize(start);
+  return os;
+}
+
+// Stream pieces to `os` through the `append_join_with` machinery, with
+// `delim`.
+template<auto opt = join_opt::braced, char open = 0, char close = 0>
+auto& buffered_out_with(OStreamDerived auto& os, delim d,
+    const auto&... parts) {
+  auto& b = details::stream_buffer();
+  const auto start = b.size();
+  append_join_with<opt, open, close>(b, d, parts...);
+  os.rdbuf()->sputn(b.data() + start,
+      static_cast<std::streamsize>(b.size() - start));
+  b.resize(start);
+  return os;
+}
+
 } // namespace joining
 } // namespace corvid::strings
 
@@ -721,10 +822,6 @@ append_json(AppendTarget auto& target, const auto& head, const auto&... tail) {
 // TODO
 //
 
-// TODO: Add method that takes pieces and counts up their total (estimated)
-// size, for the purpose of reserving target capacity. Possibly add this an a
-// `join_opt` for use in `concat` and `join`.
-
 // TODO: Benchmark delim `find` single-char optimizations, to make sure they're
 // faster.
 
@@ -15,6 +15,13 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 #pragma once
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <span>
+
 #include "strings_shared.h"
 #include "trimming.h"
 #include "../enums/enum_registry.h"
@@ -23,46 +30,148 @@ namespace corvid::strings { inline namespace conversion {
 
 inline namespace cvt_fix_from_chars {
 
-#ifdef _LIBCPP_VERSION
+namespace details {
 
-// Ugly workaround for the fact that std::from_chars is not available in
-// libstdc++. Does not honor `fmt`.
+// Case-insensitive match of lowercase `word` at [p, last), returning the end
+// of the match or nullptr.
+[[nodiscard]] inline const char* match_ci(const char* p, const char* last,
+    std::string_view word) noexcept {
+  for (auto ch : word) {
+    if (p == last || (*p | 0x20) != ch) return nullptr;
+    ++p;
+  }
+  return p;
+}
+
+// Self-contained floating-point parser with `std::from_chars` semantics for
+// `std::chars_format::general`: longest valid prefix, no leading whitespace,
+// no "0x", case-insensitive "inf"/"infinity"/"nan". The common case -- a
+// mantissa of up to 19 digits with a small decimal exponent -- is converted
+// with a single exactly-rounded multiply or divide (the fast path shared by
+// the Clinger and Eisel-Lemire algorithms) without allocating or throwing.
+// Only the rare hard cases fall back to `strtod` over a stack copy.
 template<typename T>
-std::from_chars_result std_from_chars(const char* first, const char* last,
-    T& value, std::chars_format fmt = std::chars_format::general) {
-  std::string str(first, last);
-  (void)fmt;
-  try {
-    size_t idx;
-
-    // Use if constexpr to select the correct parsing function based on the
-    // type T
-    if constexpr (std::is_same_v<T, float>) {
-      value = std::stof(str, &idx);
-    } else if constexpr (std::is_same_v<T, double>) {
-      value = std::stod(str, &idx);
-    } else {
-      static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>,
-          "Unsupported type. Only float and double are supported.");
+std::from_chars_result fast_from_chars(const char* first, const char* last,
+    T& value) {
+  static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>,
+      "Unsupported type. Only float and double are supported.");
+  const char* p = first;
+  bool neg = false;
+  if (p != last && *p == '-') ++p, neg = true;
+  // Infinities and NaNs.
+  if (const auto q = match_ci(p, last, "inf")) {
+    const auto qq = match_ci(q, last, "inity");
+    value = neg ? -std::numeric_limits<T>::infinity()
+                : std::numeric_limits<T>::infinity();
+    return {qq ? qq : q, std::errc{}};
+  }
+  if (const auto q = match_ci(p, last, "nan")) {
+    value = neg ? -std::numeric_limits<T>::quiet_NaN()
+                : std::numeric_limits<T>::quiet_NaN();
+    return {q, std::errc{}};
+  }
+  // Mantissa digits, before and after the decimal point. Digits beyond what
+  // fits in 64 bits only adjust the exponent.
+  constexpr auto mant_cap =
+      (std::numeric_limits<std::uint64_t>::max() - 9) / 10;
+  std::uint64_t mant = 0;
+  std::int64_t exp10 = 0;
+  bool any = false;
+  for (; p != last && *p >= '0' && *p <= '9'; ++p) {
+    any = true;
+    if (mant <= mant_cap)
+      mant = mant * 10 + static_cast<unsigned>(*p - '0');
+    else
+      ++exp10;
+  }
+  if (p != last && *p == '.') {
+    ++p;
+    for (; p != last && *p >= '0' && *p <= '9'; ++p) {
+      any = true;
+      if (mant <= mant_cap)
+        mant = mant * 10 + static_cast<unsigned>(*p - '0'), --exp10;
     }
-
-    std::from_chars_result result;
-    result.ptr = first + idx;
-
-    // Check if the entire input was processed
-    if (result.ptr == last) {
-      result.ec = std::errc(); // No error
-    } else {
-      result.ec = std::errc::invalid_argument; // Extra unprocessed characters
+  }
+  if (!any) return {first, std::errc::invalid_argument};
+  // Optional exponent, not consumed unless it has at least one digit.
+  const char* end_num = p;
+  if (p != last && (*p == 'e' || *p == 'E')) {
+    auto q = p + 1;
+    bool eneg = false;
+    if (q != last && (*q == '+' || *q == '-')) eneg = (*q == '-'), ++q;
+    std::int64_t e = 0;
+    bool edigits = false;
+    for (; q != last && *q >= '0' && *q <= '9'; ++q) {
+      edigits = true;
+      if (e < 100'000) e = e * 10 + (*q - '0');
+    }
+    if (edigits) {
+      exp10 += eneg ? -e : e;
+      end_num = q;
     }
-    return result;
   }
-  catch (const std::invalid_argument&) {
-    return {first, std::errc::invalid_argument}; // Invalid conversion
+  // Exact fast path: a mantissa that fits the significand times a power of
+  // ten that is exactly representable resolves to a single correctly-rounded
+  // multiply or divide, in the target type's own precision.
+  constexpr int max_exact = std::is_same_v<T, double> ? 22 : 10;
+  constexpr auto max_mant = std::uint64_t{1} << std::numeric_limits<T>::digits;
+  static constexpr auto powers = [] {
+    std::array<T, max_exact + 1> a{};
+    T v = 1;
+    for (auto& x : a) x = v, v *= 10;
+    return a;
+  }();
+  if (mant <= max_mant && exp10 >= -max_exact && exp10 <= max_exact) {
+    auto result = static_cast<T>(mant);
+    if (exp10 >= 0)
+      result *= powers[exp10];
+    else
+      result /= powers[-exp10];
+    value = neg ? -result : result;
+    return {end_num, std::errc{}};
   }
-  catch (const std::out_of_range&) {
-    return {first, std::errc::result_out_of_range}; // Value out of range
+  // Hard cases: strtod over a bounded, null-terminated copy. No exceptions,
+  // and no allocation unless the number is absurdly long.
+  std::array<char, 128> buf;
+  std::string heap;
+  const char* cstr;
+  const auto len = static_cast<size_t>(end_num - first);
+  if (len < buf.size()) {
+    std::memcpy(buf.data(), first, len);
+    buf[len] = '\0';
+    cstr = buf.data();
+  } else {
+    heap.assign(first, end_num);
+    cstr = heap.c_str();
   }
+  errno = 0;
+  char* endp{};
+  T parsed;
+  if constexpr (std::is_same_v<T, float>)
+    parsed = std::strtof(cstr, &endp);
+  else
+    parsed = std::strtod(cstr, &endp);
+  // Note: strtod flags subnormal results with ERANGE, but they are exactly
+  // representable, so only overflow and total underflow count as errors.
+  if (errno == ERANGE &&
+      (parsed == 0 || parsed == std::numeric_limits<T>::infinity() ||
+          parsed == -std::numeric_limits<T>::infinity()))
+    return {end_num, std::errc::result_out_of_range};
+  value = parsed;
+  return {end_num, std::errc{}};
+}
+
+} // namespace details
+
+#ifdef _LIBCPP_VERSION
+
+// Workaround for platforms whose standard library lacks floating-point
+// `std::from_chars`. Does not honor `fmt`; always parses as `general`.
+template<typename T>
+std::from_chars_result std_from_chars(const char* first, const char* last,
+    T& value, std::chars_format fmt = std::chars_format::general) {
+  (void)fmt;
+  return details::fast_from_chars(first, last, value);
 }
 #else
 
@@ -145,28 +254,95 @@ constexpr T parse_num(std::string_view sv, std::integral auto default_value) {
   return (extract_num<base>(t, sv) && sv.empty()) ? t : default_value;
 }
 
+namespace details {
+
+// Lookup table of all two-digit pairs, "00" through "99".
+inline constexpr auto digit_pairs = [] {
+  std::array<char, 200> a{};
+  for (int i = 0; i < 100; ++i) {
+    a[2 * i] = static_cast<char>('0' + i / 10);
+    a[2 * i + 1] = static_cast<char>('0' + i % 10);
+  }
+  return a;
+}();
+
+// Count of base-10 digits in `v`; at least 1.
+[[nodiscard]] constexpr size_t count_digits10(uint64_t v) noexcept {
+  size_t n = 1;
+  for (;;) {
+    if (v < 10) return n;
+    if (v < 100) return n + 1;
+    if (v < 1'000) return n + 2;
+    if (v < 10'000) return n + 3;
+    v /= 10'000;
+    n += 4;
+  }
+}
+
+// Write `v` in base 10 ending just before `end`, two digits per iteration.
+// The caller must reserve `count_digits10(v)` bytes before `end`.
+constexpr void write_digits10(char* end, uint64_t v) noexcept {
+  while (v >= 100) {
+    const auto pair = 2 * (v % 100);
+    v /= 100;
+    *--end = digit_pairs[pair + 1];
+    *--end = digit_pairs[pair];
+  }
+  if (v >= 10) {
+    *--end = digit_pairs[2 * v + 1];
+    *--end = digit_pairs[2 * v];
+  } else {
+    *--end = static_cast<char>('0' + v);
+  }
+}
+
+} // namespace details
+
 // Append integral number to `target`. Hex is prefixed with "0x" and
 // zero-padded to an appropriate size. Returns `target`.
+//
+// Base 10 bypasses `std::to_chars` for a table-driven two-digits-at-a-time
+// conversion; with `width` and `pad` fixed as template parameters, a padded
+// small-integer append boils down to a handful of stores.
 template<int base = 10, size_t width = 0, char pad = ' '>
 constexpr auto& append_num(AppendTarget auto& target, Integer auto num) {
   auto a = appender{target};
-  std::array<char, 64> b;
-  auto [ptr, ec] = std::to_chars(b.data(), b.data() + b.size(), num, base);
-  if (ec != std::errc{}) return target;
-  size_t len = ptr - b.data();
-  // Apply padding and prefix.
-  if constexpr ((width && pad) || base == 16) {
-    auto w = width;
-    auto p = pad;
-    if constexpr (base == 16 && !width) {
-      a.append("0x"sv);
-      p = '0';
-      w = sizeof(num) * 2;
+  if constexpr (base == 10) {
+    // Fast path: measure, pad, then emit sign and digit pairs.
+    auto u = static_cast<uint64_t>(num);
+    bool neg = false;
+    if constexpr (std::is_signed_v<decltype(num)>)
+      if (num < 0) {
+        neg = true;
+        u = uint64_t{} - u;
+      }
+    std::array<char, 24> b;
+    const auto digits = details::count_digits10(u);
+    const auto len = digits + neg;
+    if (neg) b[0] = '-';
+    details::write_digits10(b.data() + len, u);
+    if constexpr (width && pad)
+      if (len < width) a.append(width - len, pad);
+    return *a.append(b.data(), len);
+  } else {
+    std::array<char, 64> b;
+    auto [ptr, ec] = std::to_chars(b.data(), b.data() + b.size(), num, base);
+    if (ec != std::errc{}) return target;
+    size_t len = ptr - b.data();
+    // Apply padding and prefix.
+    if constexpr ((width && pad) || base == 16) {
+      auto w = width;
+      auto p = pad;
+      if constexpr (base == 16 && !width) {
+        a.append("0x"sv);
+        p = '0';
+        w = sizeof(num) * 2;
+      }
+      if (len < w) a.append(w - len, p);
     }
-    if (len < w) a.append(w - len, p);
+    // Append number.
+    return *a.append(b.data(), len);
   }
-  // Append number.
-  return *a.append(b.data(), len);
 }
 
 // Append bool, as number, to `target`.  Returns `target`.
@@ -281,7 +457,294 @@ constexpr std::string num_as_string(std::floating_point auto num) {
   return append_num<fmt, precision, width, pad>(target, num);
 }
 
+// Append floating-point number with exactly `precision` decimals, as
+// `chars_format::fixed` would, but skipping the shortest-round-trip
+// machinery entirely: the value is scaled to an integer, emitted through
+// the two-digits-at-a-time base-10 path, and the decimal point inserted.
+// For telemetry-style fields whose precision is known at compile time,
+// this is several times cheaper than `std::to_chars`.
+//
+// Rounding is half-away-from-zero, not the half-even of `std::to_chars`,
+// so a value exactly between representable outputs may print one ulp
+// differently. Values too large to scale into a `uint64_t`, along with
+// nan and infinity, fall back to `std::to_chars`.
+template<int precision, size_t width = 0, char pad = ' '>
+requires(precision >= 0 && precision <= 18)
+constexpr auto&
+append_num(AppendTarget auto& target, std::floating_point auto num) {
+  auto a = appender{target};
+  constexpr auto scale = [] {
+    uint64_t s = 1;
+    for (int i = 0; i < precision; ++i) s *= 10;
+    return s;
+  }();
+  constexpr auto max_abs = 9.0e18 / static_cast<double>(scale);
+  const auto d = static_cast<double>(num);
+  if (!(d >= -max_abs && d <= max_abs)) [[unlikely]]
+    return append_num<std::chars_format::fixed, precision, width, pad>(target,
+        num);
+  const bool neg = d < 0;
+  const auto scaled =
+      static_cast<uint64_t>((neg ? -d : d) * static_cast<double>(scale) + 0.5);
+  const auto whole = scaled / scale;
+  const auto frac = scaled % scale;
+  std::array<char, 44> b;
+  const auto digits = cvt_int::details::count_digits10(whole);
+  size_t len = digits + neg;
+  if (neg) b[0] = '-';
+  cvt_int::details::write_digits10(b.data() + len, whole);
+  if constexpr (precision > 0) {
+    b[len++] = '.';
+    const auto frac_digits = cvt_int::details::count_digits10(frac);
+    for (auto i = frac_digits; i < size_t{precision}; ++i) b[len++] = '0';
+    len += frac_digits;
+    cvt_int::details::write_digits10(b.data() + len, frac);
+  }
+  if constexpr (width && pad)
+    if (len < width) a.append(width - len, pad);
+  return *a.append(b.data(), len);
+}
+
+// Return floating-point number as string with fixed `precision` decimals.
+template<int precision, size_t width = 0, char pad = ' '>
+requires(precision >= 0 && precision <= 18)
+constexpr std::string num_as_string(std::floating_point auto num) {
+  std::string target;
+  return append_num<precision, width, pad>(target, num);
+}
+
 } // namespace cvt_float
+inline namespace cvt_batch {
+
+// Batch parsing.
+
+// Parse a delimited list of numbers out of `whole` into `out` in a single
+// fused pass, returning the count parsed. This avoids the per-field
+// call and rescan overhead of `extract_piece` followed by `parse_num`: each
+// number is extracted directly from the remaining input, and the next
+// character is then required to be one of the delimiters.
+//
+// Parsing stops when `out` is full, at the end of the input, at the first
+// field that does not parse cleanly as a number, or at the first separator
+// that is not a single delimiter character. Leading whitespace before each
+// number is allowed, as with `parse_num`.
+template<int base = 10, std::integral T, size_t extent = std::dynamic_extent>
+constexpr size_t
+parse_nums(std::string_view whole, std::span<T, extent> out, delim d = {}) {
+  size_t cnt = 0;
+  while (cnt < out.size() && extract_num<base>(out[cnt], whole)) {
+    ++cnt;
+    if (whole.empty()) break;
+    if (d.find(whole.front()) == std::string_view::npos) break;
+    whole.remove_prefix(1);
+  }
+  return cnt;
+}
+
+// Same, but for floating-point numbers.
+template<std::chars_format fmt = std::chars_format::general,
+    std::floating_point T, size_t extent = std::dynamic_extent>
+constexpr size_t
+parse_nums(std::string_view whole, std::span<T, extent> out, delim d = {}) {
+  size_t cnt = 0;
+  while (cnt < out.size() && extract_num<fmt>(out[cnt], whole)) {
+    ++cnt;
+    if (whole.empty()) break;
+    if (d.find(whole.front()) == std::string_view::npos) break;
+    whole.remove_prefix(1);
+  }
+  return cnt;
+}
+
+} // namespace cvt_batch
+
+inline namespace cvt_codec {
+
+// Binary codecs.
+//
+// Hex and base64 for spans of bytes, as used for hashes and tokens. The
+// encoders run off lookup tables, batching output through a stack buffer so
+// encoded text streams straight into any `AppendTarget`; the extractors
+// follow the `extract_num` contract, consuming as much valid input as they
+// can and failing without side effects when none is consumable.
+
+namespace details {
+
+// Lookup table of both hex digits for every byte value, lowercase.
+inline constexpr auto hex_pairs = [] {
+  std::array<char, 512> a{};
+  constexpr std::string_view digits = "0123456789abcdef";
+  for (int i = 0; i < 256; ++i) {
+    a[2 * i] = digits[i >> 4];
+    a[2 * i + 1] = digits[i & 15];
+  }
+  return a;
+}();
+
+// Value of each hex digit, or -1.
+inline constexpr auto hex_values = [] {
+  std::array<int8_t, 256> a{};
+  a.fill(-1);
+  for (int i = 0; i < 10; ++i) a['0' + i] = static_cast<int8_t>(i);
+  for (int i = 0; i < 6; ++i) {
+    a['a' + i] = static_cast<int8_t>(10 + i);
+    a['A' + i] = static_cast<int8_t>(10 + i);
+  }
+  return a;
+}();
+
+inline constexpr std::string_view base64_alphabet =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+// Value of each base64 digit, or -1.
+inline constexpr auto base64_values = [] {
+  std::array<int8_t, 256> a{};
+  a.fill(-1);
+  for (int i = 0; i < 64; ++i)
+    a[static_cast<unsigned char>(base64_alphabet[i])] =
+        static_cast<int8_t>(i);
+  return a;
+}();
+
+} // namespace details
+
+// Append `bytes` to `target` as lowercase hex, without a prefix. Returns
+// `target`.
+constexpr auto&
+append_hex(AppendTarget auto& target, std::span<const std::byte> bytes) {
+  auto a = appender{target};
+  std::array<char, 128> b;
+  while (!bytes.empty()) {
+    const auto chunk = bytes.first(std::min(bytes.size(), b.size() / 2));
+    char* p = b.data();
+    for (const auto byte : chunk) {
+      const auto pair = 2 * std::to_integer<size_t>(byte);
+      *p++ = details::hex_pairs[pair];
+      *p++ = details::hex_pairs[pair + 1];
+    }
+    a.append(b.data(), static_cast<size_t>(p - b.data()));
+    bytes = bytes.subspan(chunk.size());
+  }
+  return target;
+}
+
+// Extract hex digit pairs from the front of `sv`, in either case, appending
+// the decoded bytes to `out`.
+//
+// On success, removes the parsed characters and returns true. An unpaired
+// trailing digit is left unparsed. Fails, changing nothing, if no pair is
+// parsable.
+constexpr bool extract_hex(std::vector<std::byte>& out, std::string_view& sv) {
+  size_t n = 0;
+  while (n + 2 <= sv.size() &&
+         details::hex_values[static_cast<unsigned char>(sv[n])] >= 0 &&
+         details::hex_values[static_cast<unsigned char>(sv[n + 1])] >= 0)
+    n += 2;
+  if (!n) return false;
+  out.reserve(out.size() + n / 2);
+  for (size_t i = 0; i < n; i += 2) {
+    const auto hi = details::hex_values[static_cast<unsigned char>(sv[i])];
+    const auto lo = details::hex_values[static_cast<unsigned char>(sv[i + 1])];
+    out.push_back(static_cast<std::byte>((hi << 4) | lo));
+  }
+  sv.remove_prefix(n);
+  return true;
+}
+
+// Append `bytes` to `target` as base64, with `=` padding, per RFC 4648.
+// Returns `target`.
+constexpr auto&
+append_base64(AppendTarget auto& target, std::span<const std::byte> bytes) {
+  auto a = appender{target};
+  constexpr auto& alphabet = details::base64_alphabet;
+  std::array<char, 64> b;
+  while (!bytes.empty()) {
+    // Whole chunks stay group-aligned, so padding can only land at the end.
+    const auto chunk = bytes.first(std::min(bytes.size(), size_t{48}));
+    char* p = b.data();
+    size_t i = 0;
+    for (; i + 3 <= chunk.size(); i += 3) {
+      const auto v = std::to_integer<uint32_t>(chunk[i]) << 16 |
+                     std::to_integer<uint32_t>(chunk[i + 1]) << 8 |
+                     std::to_integer<uint32_t>(chunk[i + 2]);
+      *p++ = alphabet[v >> 18];
+      *p++ = alphabet[(v >> 12) & 63];
+      *p++ = alphabet[(v >> 6) & 63];
+      *p++ = alphabet[v & 63];
+    }
+    if (const auto rem = chunk.size() - i) {
+      auto v = std::to_integer<uint32_t>(chunk[i]) << 16;
+      if (rem == 2) v |= std::to_integer<uint32_t>(chunk[i + 1]) << 8;
+      *p++ = alphabet[v >> 18];
+      *p++ = alphabet[(v >> 12) & 63];
+      *p++ = rem == 2 ? alphabet[(v >> 6) & 63] : '=';
+      *p++ = '=';
+    }
+    a.append(b.data(), static_cast<size_t>(p - b.data()));
+    bytes = bytes.subspan(chunk.size());
+  }
+  return target;
+}
+
+// Extract base64 groups from the front of `sv`, appending the decoded bytes
+// to `out`. Stops after a padded group or at the first invalid or partial
+// group.
+//
+// On success, removes the parsed characters and returns true. Fails, changing
+// nothing, if no group is parsable.
+constexpr bool
+extract_base64(std::vector<std::byte>& out, std::string_view& sv) {
+  const auto value = [](char c) {
+    return details::base64_values[static_cast<unsigned char>(c)];
+  };
+  size_t pos = 0;
+  while (pos + 4 <= sv.size()) {
+    const auto v0 = value(sv[pos]);
+    const auto v1 = value(sv[pos + 1]);
+    if (v0 < 0 || v1 < 0) break;
+    const char c2 = sv[pos + 2];
+    const char c3 = sv[pos + 3];
+    if (c2 == '=') {
+      if (c3 != '=') break;
+      out.push_back(static_cast<std::byte>(v0 << 2 | v1 >> 4));
+      pos += 4;
+      break;
+    }
+    const auto v2 = value(c2);
+    if (v2 < 0) break;
+    if (c3 == '=') {
+      out.push_back(static_cast<std::byte>(v0 << 2 | v1 >> 4));
+      out.push_back(static_cast<std::byte>((v1 & 15) << 4 | v2 >> 2));
+      pos += 4;
+      break;
+    }
+    const auto v3 = value(c3);
+    if (v3 < 0) break;
+    out.push_back(static_cast<std::byte>(v0 << 2 | v1 >> 4));
+    out.push_back(static_cast<std::byte>((v1 & 15) << 4 | v2 >> 2));
+    out.push_back(static_cast<std::byte>((v2 & 3) << 6 | v3));
+    pos += 4;
+  }
+  if (!pos) return false;
+  sv.remove_prefix(pos);
+  return true;
+}
+
+// Return `bytes` as hex string.
+[[nodiscard]] constexpr std::string
+hex_as_string(std::span<const std::byte> bytes) {
+  std::string target;
+  return append_hex(target, bytes);
+}
+
+// Return `bytes` as base64 string.
+[[nodiscard]] constexpr std::string
+base64_as_string(std::span<const std::byte> bytes) {
+  std::string target;
+  return append_base64(target, bytes);
+}
+
+} // namespace cvt_codec
 
 inline namespace cvt_enum {
 
@@ -321,12 +784,47 @@ inline namespace cvt_stream {
 template<OStreamable T>
 constexpr bool stream_append_v = false;
 
+namespace details {
+
+// A `std::streambuf` that appends everything to a `std::string`, so that
+// `operator<<` formatting can land in an existing buffer instead of a
+// temporary `std::stringstream`.
+class append_streambuf final : public std::streambuf {
+public:
+  void attach(std::string* s) noexcept { s_ = s; }
+
+protected:
+  int_type overflow(int_type ch) override {
+    if (ch != traits_type::eof()) s_->push_back(static_cast<char>(ch));
+    return ch;
+  }
+  std::streamsize xsputn(const char* p, std::streamsize n) override {
+    s_->append(p, static_cast<size_t>(n));
+    return n;
+  }
+
+private:
+  std::string* s_{};
+};
+
+} // namespace details
+
 // Append streamable `t` to `target`. Returns `target`.
+//
+// String targets format through a thread-local scratch buffer whose capacity
+// is reused across calls, so this allocates nothing after warmup. The
+// scratch is treated as a stack, which keeps reentrant streaming safe.
 auto& append_stream(AppendTarget auto& target, const OStreamable auto& t) {
   if constexpr (StringViewConvertible<decltype(target)>) {
-    std::stringstream s;
-    s << t;
-    target.append(s.str());
+    static thread_local std::string scratch;
+    static thread_local details::append_streambuf buf;
+    static thread_local std::ostream os{&buf};
+    const auto start = scratch.size();
+    buf.attach(&scratch);
+    os.clear();
+    os << t;
+    target.append(std::string_view{scratch}.substr(start));
+    scratch.resize(start);
   } else {
     target << t;
   }
@@ -16,6 +16,7 @@
 // limitations under the License.
 #pragma once
 #include "strings_shared.h"
+#include "locating.h"
 #include "targeting.h"
 
 namespace corvid::strings { inline namespace delimiting {
@@ -40,21 +41,33 @@ struct delim: public std::string_view {
   // TODO: Construct from initializer list of char.
 
   template<typename T>
-  constexpr delim(T&& list) : std::string_view(std::forward<T>(list)) {}
+  constexpr delim(T&& list)
+      : std::string_view(std::forward<T>(list)),
+        in_{std::span<const char>{data(), size()}} {}
+
+  // Note: The multi-character cases below test each byte against a 256-bit
+  // membership bitmap built at construction, which is a single table lookup
+  // instead of a nested scan over the delimiter set.
 
   [[nodiscard]] constexpr auto find_in(std::string_view whole) const {
     if (size() == 1) return whole.find(front());
-    return whole.find_first_of(*this);
+    for (size_t pos = 0; pos != whole.size(); ++pos)
+      if (in_.test(whole[pos])) return pos;
+    return npos;
   }
 
   [[nodiscard]] constexpr auto find_not_in(std::string_view whole) const {
     if (size() == 1) return whole.find_first_not_of(front());
-    return whole.find_first_not_of(*this);
+    for (size_t pos = 0; pos != whole.size(); ++pos)
+      if (!in_.test(whole[pos])) return pos;
+    return npos;
   }
 
   [[nodiscard]] constexpr auto find_last_not_in(std::string_view whole) const {
     if (size() == 1) return whole.find_last_not_of(front());
-    return whole.find_last_not_of(*this);
+    for (auto pos = whole.size(); pos != 0;)
+      if (!in_.test(whole[--pos])) return pos;
+    return npos;
   }
 
   // Append.
@@ -83,6 +96,10 @@ struct delim: public std::string_view {
     if constexpr (emit) append(target);
     return target;
   }
+
+private:
+  // Membership bitmap over the delimiter characters.
+  locating::details::char_bitmap in_;
 };
 
 }} // namespace corvid::strings::delimiting
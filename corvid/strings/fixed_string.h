@@ -32,6 +32,9 @@ namespace corvid::strings { inline namespace fixed {
 // https://www.open-std.org/jtc1/sc22/wg21/docs/papers/2016/p0259r0.pdf
 template<unsigned N>
 struct fixed_string {
+  // Construct as empty, to be filled in by compile-time builders.
+  constexpr fixed_string() = default;
+
   // Construct from a string literal. Requires `N` to be specified by the
   // deduction guide.
   constexpr fixed_string(char const* s) {
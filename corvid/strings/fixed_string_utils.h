@@ -53,6 +53,52 @@ consteval auto fixed_split_trim() {
   return fixed_split<W, D, WS>();
 }
 
+// Concatenate fixed strings into a single `fixed_string` at compile time, so
+// the combined literal is a zero-cost constant instead of being built at
+// startup through `concat`.
+//
+// Usage:
+//   constexpr auto k = constexpr_concat<"abc", "def">(); // "abcdef"
+template<strings::fixed_string... Parts>
+consteval auto constexpr_concat() {
+  constexpr auto total =
+      (0u + ... + static_cast<unsigned>(Parts.view().size()));
+  std::array<char, total + 1> buf{};
+  size_t at = 0;
+  const auto copy = [&](std::string_view part) {
+    for (const char c : part) buf[at++] = c;
+  };
+  (copy(Parts.view()), ...);
+  (void)copy; // Unused when the pack is empty.
+  return strings::fixed_string<total>{buf.data()};
+}
+
+// Join fixed strings with the delimiter `D`, at compile time, into a single
+// `fixed_string`. This is a flat join: no braces or quotes, just the parts
+// separated by the delimiter.
+//
+// Usage:
+//   constexpr auto k = constexpr_join<", ", "a", "b", "c">(); // "a, b, c"
+template<strings::fixed_string D, strings::fixed_string... Parts>
+consteval auto constexpr_join() {
+  constexpr auto n = static_cast<unsigned>(sizeof...(Parts));
+  constexpr auto total =
+      (0u + ... + static_cast<unsigned>(Parts.view().size())) +
+      (n ? (n - 1) * static_cast<unsigned>(D.view().size()) : 0u);
+  std::array<char, total + 1> buf{};
+  size_t at = 0;
+  bool first = true;
+  const auto copy = [&](std::string_view part) {
+    if (!first)
+      for (const char c : D.view()) buf[at++] = c;
+    first = false;
+    for (const char c : part) buf[at++] = c;
+  };
+  (copy(Parts.view()), ...);
+  (void)copy; // Unused when the pack is empty.
+  return strings::fixed_string<total>{buf.data()};
+}
+
 // TODO: Consider writing a version of split that also does a search/replace in
 // parallel, as by calling search_and_replace.  Might even take a list of froms
 // and to's.
@@ -15,6 +15,10 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 #pragma once
+#include <bit>
+#include <cstdint>
+#include <cstring>
+
 #include "strings_shared.h"
 
 // Search and replace, except `search`, `find`, `replace`, and `erase` are all
@@ -55,6 +59,8 @@
 // - substitute: Substitute all `from` with matching `to`.
 // - excise: Excise all occurrences of the values.
 // - substituted, excised: Same, but returning modified string.
+// - locate_nocase, located_nocase, substitute_nocase: ASCII
+//   case-insensitive variants of the single-value functions.
 //
 // There's also `point_past`, which works with `located`, and some other
 // largely internal functions, such as `value_size`,  `min_value_size`,
@@ -240,6 +246,197 @@ inline constexpr position point_past(location& loc,
   return point_past(loc, std::span{values.begin(), values.end()});
 }
 
+//
+// Fast-scan kernels
+//
+
+namespace details {
+
+// Bitmap over all 256 `unsigned char` values, for O(1) membership tests.
+struct char_bitmap {
+  std::array<std::uint64_t, 4> bits{};
+
+  constexpr char_bitmap() noexcept = default;
+  constexpr explicit char_bitmap(std::span<const char> values) noexcept {
+    for (auto value : values) set(value);
+  }
+
+  constexpr void set(char value) noexcept {
+    const auto u = static_cast<unsigned char>(value);
+    bits[u >> 6] |= std::uint64_t{1} << (u & 63U);
+  }
+
+  [[nodiscard]] constexpr bool test(char value) const noexcept {
+    const auto u = static_cast<unsigned char>(value);
+    return ((bits[u >> 6] >> (u & 63U)) & 1U) != 0;
+  }
+};
+
+// SWAR (SIMD-within-a-register) primitives, operating on eight bytes at a
+// time. With optimization enabled, the word loop below compiles down to
+// vector instructions on every mainstream target, without intrinsics or
+// per-platform dispatch, so a single portable kernel serves SSE, AVX and
+// NEON machines alike.
+inline constexpr std::uint64_t swar_ones = 0x0101'0101'0101'0101ULL;
+inline constexpr std::uint64_t swar_highs = 0x8080'8080'8080'8080ULL;
+
+// Replicate `value` into all eight byte lanes.
+[[nodiscard]] constexpr std::uint64_t swar_broadcast(char value) noexcept {
+  return swar_ones * static_cast<unsigned char>(value);
+}
+
+// Yield a word whose high bit is set in each lane that holds a zero byte.
+[[nodiscard]] constexpr std::uint64_t swar_zero_lanes(
+    std::uint64_t word) noexcept {
+  return (word - swar_ones) & ~word & swar_highs;
+}
+
+// As `swar_zero_lanes`, but exact in every lane. The cheaper form lets a
+// borrow from a zero lane spill into the lane above, which can flag a
+// nonzero lane; that's harmless when only the first flagged lane is used,
+// but not when the flags are counted with a popcount.
+[[nodiscard]] constexpr std::uint64_t swar_zero_lanes_exact(
+    std::uint64_t word) noexcept {
+  const auto sums = (word & ~swar_highs) + ~swar_highs;
+  return ~(sums | word) & swar_highs;
+}
+
+// Load eight bytes, unaligned.
+[[nodiscard]] inline std::uint64_t swar_load(const char* p) noexcept {
+  std::uint64_t word;
+  std::memcpy(&word, p, sizeof(word));
+  return word;
+}
+
+// ASCII-only lowercase fold, same as the `cases.h` one, which can't be used
+// here because `cases.h` includes this header.
+[[nodiscard]] constexpr char fold_lower(char c) noexcept {
+  return (c >= 'A' && c <= 'Z') ? static_cast<char>(c + ('a' - 'A')) : c;
+}
+
+// Word with the high bit flagged in each lane holding an ASCII uppercase
+// letter. The additions propagate a carry into the high bit of every lane
+// at or above each bound, and masking with `~word` confines the result to
+// seven-bit lanes.
+[[nodiscard]] constexpr std::uint64_t swar_upper_lanes(
+    std::uint64_t word) noexcept {
+  const auto sevens = word & ~swar_highs;
+  const auto ge_a = sevens + swar_ones * (0x80 - 'A');
+  const auto gt_z = sevens + swar_ones * (0x80 - 'Z' - 1);
+  return ge_a & ~gt_z & ~word & swar_highs;
+}
+
+// Fold ASCII uppercase lanes to lowercase; all other lanes pass through.
+// The flag bit, shifted down, is precisely the ASCII case bit, 0x20.
+[[nodiscard]] constexpr std::uint64_t swar_to_lower(
+    std::uint64_t word) noexcept {
+  return word | (swar_upper_lanes(word) >> 2);
+}
+
+// Index of the first flagged lane in a nonzero result of `swar_zero_lanes`.
+[[nodiscard]] constexpr size_t swar_first_lane(std::uint64_t lanes) noexcept {
+  if constexpr (std::endian::native == std::endian::little)
+    return static_cast<size_t>(std::countr_zero(lanes)) / 8;
+  else
+    return static_cast<size_t>(std::countl_zero(lanes)) / 8;
+}
+
+// As the single-value `locate`, but under ASCII case folding: both the word
+// and the needle are folded to lowercase on the fly, so the pass costs the
+// same as a sensitive scan and allocates nothing.
+[[nodiscard]] inline position locate_byte_nocase(std::string_view s,
+    char value, position pos) noexcept {
+  const auto folded = fold_lower(value);
+  const auto needle = swar_broadcast(folded);
+  for (; pos + 8 <= s.size(); pos += 8) {
+    const auto lanes =
+        swar_zero_lanes(swar_to_lower(swar_load(s.data() + pos)) ^ needle);
+    if (lanes) return pos + swar_first_lane(lanes);
+  }
+  for (; pos < s.size(); ++pos)
+    if (fold_lower(s[pos]) == folded) return pos;
+  return npos;
+}
+
+// Locate the first byte of `s`, at or after `pos`, that is in `values`,
+// returning its pos or `npos`. Small value lists compare each word against
+// every value using SWAR; larger ones do a bitmap test per byte. Either
+// way, the cost is O(n), unlike the naive O(n*m) nested scan.
+[[nodiscard]] inline position locate_any_of(std::string_view s,
+    std::span<const char> values, position pos) noexcept {
+  if (pos >= s.size()) return npos;
+  constexpr size_t max_swar_values = 8;
+  if (values.size() <= max_swar_values) {
+    std::array<std::uint64_t, max_swar_values> needles{};
+    for (size_t i = 0; i < values.size(); ++i)
+      needles[i] = swar_broadcast(values[i]);
+    for (; pos + 8 <= s.size(); pos += 8) {
+      const auto word = swar_load(s.data() + pos);
+      std::uint64_t lanes{};
+      for (size_t i = 0; i < values.size(); ++i)
+        lanes |= swar_zero_lanes(word ^ needles[i]);
+      if (lanes) return pos + swar_first_lane(lanes);
+    }
+    for (; pos < s.size(); ++pos)
+      for (auto value : values)
+        if (s[pos] == value) return pos;
+    return npos;
+  }
+  const char_bitmap bm{values};
+  for (; pos < s.size(); ++pos)
+    if (bm.test(s[pos])) return pos;
+  return npos;
+}
+
+// Count the bytes of `s`, at or after `pos`, equal to `value`. Each matching
+// lane contributes exactly one high bit to the mask, so a word's matches are
+// tallied with a single popcount instead of a branch per byte, and the pass
+// runs at memory bandwidth. Used to pre-size structures by counting line
+// breaks or separators in large buffers.
+[[nodiscard]] inline size_t count_byte(std::string_view s, char value,
+    position pos) noexcept {
+  size_t cnt{};
+  const auto needle = swar_broadcast(value);
+  for (; pos + 8 <= s.size(); pos += 8)
+    cnt += static_cast<size_t>(std::popcount(
+        swar_zero_lanes_exact(swar_load(s.data() + pos) ^ needle)));
+  for (; pos < s.size(); ++pos) cnt += s[pos] == value;
+  return cnt;
+}
+
+// As `count_byte`, but counting bytes in `values`. Small value lists OR the
+// per-value lane masks before the popcount, which stays correct even when
+// `values` holds duplicates; larger ones do a bitmap test per byte.
+[[nodiscard]] inline size_t count_any_of(std::string_view s,
+    std::span<const char> values, position pos) noexcept {
+  size_t cnt{};
+  constexpr size_t max_swar_values = 8;
+  if (values.size() <= max_swar_values) {
+    std::array<std::uint64_t, max_swar_values> needles{};
+    for (size_t i = 0; i < values.size(); ++i)
+      needles[i] = swar_broadcast(values[i]);
+    for (; pos + 8 <= s.size(); pos += 8) {
+      const auto word = swar_load(s.data() + pos);
+      std::uint64_t lanes{};
+      for (size_t i = 0; i < values.size(); ++i)
+        lanes |= swar_zero_lanes_exact(word ^ needles[i]);
+      cnt += static_cast<size_t>(std::popcount(lanes));
+    }
+    for (; pos < s.size(); ++pos)
+      for (auto value : values)
+        if (s[pos] == value) {
+          ++cnt;
+          break;
+        }
+    return cnt;
+  }
+  const char_bitmap bm{values};
+  for (; pos < s.size(); ++pos) cnt += bm.test(s[pos]);
+  return cnt;
+}
+
+} // namespace details
+
 //
 // Locate
 //
@@ -337,6 +534,13 @@ template<npos_choice npv = npos_choice::npos>
 template<npos_choice npv = npos_choice::npos>
 [[nodiscard]] constexpr location locate(std::string_view s,
     std::span<const char> values, position pos = 0) noexcept {
+  if (!std::is_constant_evaluated()) {
+    if (const auto found = details::locate_any_of(s, values, pos);
+        found != npos)
+      for (position pos_value = 0; pos_value < values.size(); ++pos_value)
+        if (s[found] == values[pos_value]) return {found, pos_value};
+    return as_nloc<npv>(s, values);
+  }
   for (; pos < s.size(); ++pos)
     for (position pos_value = 0; pos_value < values.size(); ++pos_value)
       if (s[pos] == values[pos_value]) return {pos, pos_value};
@@ -540,15 +744,21 @@ constexpr bool rlocated(location& loc, std::string_view s,
 //
 
 // Return count of instances of a single `value` in `s`, starting at
-// `pos`.
-[[nodiscard]] size_t count_located(std::string_view s,
+// `pos`. The single-char and char-set cases count a word at a time through
+// the SWAR kernels, so pre-sizing passes over large buffers run at memory
+// bandwidth rather than costing as much as the parse itself.
+[[nodiscard]] constexpr size_t count_located(std::string_view s,
     const SingleLocateValue auto& value, position pos = 0) noexcept {
+  if constexpr (Char<decltype(value)>)
+    if (!std::is_constant_evaluated()) return details::count_byte(s, value, pos);
   size_t cnt{};
   while (located(pos, s, value)) ++cnt, point_past(pos, value);
   return cnt;
 }
 [[nodiscard]] inline constexpr size_t count_located(std::string_view s,
     std::span<const char> values, position pos = 0) noexcept {
+  if (!std::is_constant_evaluated())
+    return details::count_any_of(s, values, pos);
   size_t cnt{};
   for (location loc{pos, 0}; located(loc, s, values); ++cnt, ++loc.pos);
   return cnt;
@@ -570,6 +780,173 @@ constexpr bool rlocated(location& loc, std::string_view s,
   return count_located(s, std::span{values.begin(), values.end()}, pos);
 }
 
+//
+// compiled_locator
+//
+
+// A preprocessed matcher for locating any of a fixed list of string values.
+//
+// The free `locate` overload taking `std::span<const std::string_view>`
+// rescans the target for every value on every call, which is wasteful when
+// the same value list is matched against many targets. This class builds an
+// Aho-Corasick automaton over the values once, up front, and then locates in
+// a single pass over the target, amortizing the setup cost across calls.
+//
+// Results are identical to the free function: the leftmost match wins, and
+// ties at the same pos go to the lowest `pos_value`. The values are copied
+// into the object, so it does not dangle when the inputs go away.
+class compiled_locator {
+public:
+  compiled_locator() = default;
+
+  explicit compiled_locator(std::span<const std::string_view> values) {
+    build(values);
+  }
+  compiled_locator(std::initializer_list<std::string_view> values)
+      : compiled_locator(std::span{values.begin(), values.end()}) {}
+
+  [[nodiscard]] size_t size() const noexcept { return values_.size(); }
+  [[nodiscard]] bool empty() const noexcept { return values_.empty(); }
+
+  // The value at `pos_value`, as copied into the locator.
+  [[nodiscard]] std::string_view value(position pos_value) const noexcept {
+    return values_[pos_value];
+  }
+
+  // Locate the first instance of any of the values in `s`, starting at
+  // `pos`, returning the `location` exactly as the free `locate` overload
+  // for multiple string values does.
+  template<npos_choice npv = npos_choice::npos>
+  [[nodiscard]] location
+  locate(std::string_view s, position pos = 0) const noexcept {
+    if (nodes_.empty()) return as_nloc<npv>(s, values_);
+    position best_pos = npos;
+    position best_value = npos;
+    if (first_empty_ != npos && pos <= s.size()) {
+      best_pos = pos;
+      best_value = first_empty_;
+    }
+    std::int32_t state = 0;
+    for (position i = pos; i < s.size(); ++i) {
+      if (best_pos != npos && i - best_pos >= max_size_) break;
+      state = nodes_[static_cast<size_t>(state)]
+                  .next[static_cast<unsigned char>(s[i])];
+      const auto& n = nodes_[static_cast<size_t>(state)];
+      if (n.best_size > 0) {
+        const auto found = i + 1 - static_cast<size_t>(n.best_size);
+        const auto found_value = static_cast<position>(n.best_value);
+        if (found < best_pos ||
+            (found == best_pos && found_value < best_value)) {
+          best_pos = found;
+          best_value = found_value;
+        }
+      }
+    }
+    if (best_pos == npos) return as_nloc<npv>(s, values_);
+    return {best_pos, best_value};
+  }
+
+  // Return whether any of the values were located, updating `loc`, with the
+  // same semantics as the free `located` functions.
+  template<npos_choice npv = npos_choice::npos>
+  bool located(location& loc, std::string_view s) const noexcept {
+    return (loc = locate<npv>(s, loc.pos)).pos != as_npos<npv>(s);
+  }
+
+  // Update the `pos` in `loc` to point past the located value, returning it.
+  constexpr position point_past(location& loc) const noexcept {
+    assert(loc.pos_value < values_.size());
+    loc.pos += std::max(values_[loc.pos_value].size(), size_t{1});
+    return loc.pos;
+  }
+
+private:
+  struct node {
+    std::array<std::int32_t, 256> next;
+    std::int32_t best_size{};
+    std::int32_t best_value{};
+  };
+
+  void build(std::span<const std::string_view> values) {
+    values_.reserve(values.size());
+    for (const auto& value : values) values_.emplace_back(value);
+    nodes_.resize(1);
+    nodes_[0].next.fill(-1);
+    // Build the trie, keeping the best (longest, then lowest-index) value
+    // ending at each node.
+    for (size_t pos_value = 0; pos_value < values_.size(); ++pos_value) {
+      const auto& value = values_[pos_value];
+      if (value.empty()) {
+        if (first_empty_ == npos) first_empty_ = pos_value;
+        continue;
+      }
+      max_size_ = std::max(max_size_, value.size());
+      std::int32_t state = 0;
+      for (const auto ch : value) {
+        auto next = nodes_[static_cast<size_t>(state)]
+                        .next[static_cast<unsigned char>(ch)];
+        if (next < 0) {
+          next = static_cast<std::int32_t>(nodes_.size());
+          nodes_[static_cast<size_t>(state)]
+              .next[static_cast<unsigned char>(ch)] = next;
+          nodes_.emplace_back().next.fill(-1);
+        }
+        state = next;
+      }
+      auto& n = nodes_[static_cast<size_t>(state)];
+      if (better(static_cast<std::int32_t>(value.size()),
+              static_cast<std::int32_t>(pos_value), n)) {
+        n.best_size = static_cast<std::int32_t>(value.size());
+        n.best_value = static_cast<std::int32_t>(pos_value);
+      }
+    }
+    // Breadth-first pass to resolve failure transitions into a full DFA,
+    // folding each node's failure-chain output into its own best match.
+    std::vector<std::int32_t> fail(nodes_.size());
+    std::vector<std::int32_t> queue;
+    queue.reserve(nodes_.size());
+    for (auto& next : nodes_[0].next) {
+      if (next < 0)
+        next = 0;
+      else {
+        fail[static_cast<size_t>(next)] = 0;
+        queue.push_back(next);
+      }
+    }
+    for (size_t head = 0; head < queue.size(); ++head) {
+      const auto u = static_cast<size_t>(queue[head]);
+      const auto f = static_cast<size_t>(fail[u]);
+      if (better(nodes_[f].best_size, nodes_[f].best_value, nodes_[u])) {
+        nodes_[u].best_size = nodes_[f].best_size;
+        nodes_[u].best_value = nodes_[f].best_value;
+      }
+      for (size_t ch = 0; ch < 256; ++ch) {
+        const auto v = nodes_[u].next[ch];
+        if (v < 0)
+          nodes_[u].next[ch] = nodes_[f].next[ch];
+        else {
+          fail[static_cast<size_t>(v)] = nodes_[f].next[ch];
+          queue.push_back(v);
+        }
+      }
+    }
+  }
+
+  // Whether a candidate match beats the one recorded in `n`. Longer is
+  // better because it starts earlier at the same end; on equal size, the
+  // lower value index wins, matching the free function's tiebreak.
+  [[nodiscard]] static constexpr bool better(std::int32_t size,
+      std::int32_t value, const node& n) noexcept {
+    return n.best_size == 0 || size > n.best_size ||
+           (size == n.best_size && value < n.best_value);
+  }
+
+  std::vector<std::string> values_;
+  std::vector<node> nodes_;
+  size_t max_size_{};
+  position first_empty_{npos};
+};
+
 //
 // Substitute
 //
@@ -589,6 +966,25 @@ size_t substitute(std::string& s, SingleLocateValue auto from,
     auto to_sv = std::string_view{to};
     size_t from_size = from_sv.size();
     size_t to_size = to_sv.size() + (from_size ? 0 : 1);
+    if (from_size && from_size != to_sv.size()) {
+      // When the sizes differ, repeated replace calls shift the tail and
+      // regrow the string once per match. Instead, count the matches,
+      // compute the final size, and build the result with a single
+      // allocation and a single forward pass.
+      for (auto at = pos; located(at, s, from_sv); ++cnt) at += from_size;
+      if (!cnt) return cnt;
+      std::string result;
+      result.reserve(s.size() - cnt * from_size + cnt * to_sv.size());
+      size_t prev = 0;
+      for (auto at = pos; located(at, s, from_sv); prev = at) {
+        result.append(s, prev, at - prev);
+        result.append(to_sv);
+        at += from_size;
+      }
+      result.append(s, prev, npos);
+      s = std::move(result);
+      return cnt;
+    }
     for (; located(pos, s, from_sv); ++cnt, pos += to_size)
       s.replace(pos, from_size, to_sv);
   }
@@ -611,6 +1007,36 @@ inline size_t substitute(std::string& s,
     std::span<const std::string_view> from,
     std::span<const std::string_view> to, position pos = 0) {
   size_t cnt{};
+  bool any_empty = false;
+  bool any_resize = false;
+  for (size_t i = 0; i < from.size() && i < to.size(); ++i) {
+    any_empty = any_empty || from[i].empty();
+    any_resize = any_resize || from[i].size() != to[i].size();
+  }
+  if (!any_empty && any_resize) {
+    // Same single-allocation strategy as the single-value overload: count
+    // the matches and the final size, then build the result in one pass.
+    size_t final_size = s.size();
+    for (location loc{pos, 0}; located(loc, std::string_view{s}, from);
+         ++cnt) {
+      final_size += to[loc.pos_value].size();
+      final_size -= from[loc.pos_value].size();
+      point_past(loc, from);
+    }
+    if (!cnt) return cnt;
+    std::string result;
+    result.reserve(final_size);
+    size_t prev = 0;
+    for (location loc{pos, 0}; located(loc, std::string_view{s}, from);
+         prev = loc.pos) {
+      result.append(s, prev, loc.pos - prev);
+      result.append(to[loc.pos_value]);
+      point_past(loc, from);
+    }
+    result.append(s, prev, npos);
+    s = std::move(result);
+    return cnt;
+  }
   for (location loc{pos, 0}; located(loc, std::string_view{s}, from); ++cnt) {
     size_t from_size = from[loc.pos_value].size();
     s.replace(loc.pos, from_size, to[loc.pos_value]);
@@ -638,6 +1064,105 @@ substituted(std::string s, const auto& from, const auto& to) noexcept {
   return ss;
 }
 
+//
+// Nocase
+//
+
+// ASCII case-insensitive variants of the single-value functions. These fold
+// case on the fly, in the comparison kernel, instead of calling `as_lower`
+// on copies of both sides, so a nocase match costs the same as a sensitive
+// one and allocates nothing. Like `cases.h`, the folding is deliberately
+// ASCII-only, not locale-aware.
+
+// Return whether `a` and `b` are equal under ASCII case folding.
+[[nodiscard]] constexpr bool
+equal_nocase(std::string_view a, std::string_view b) noexcept {
+  if (a.size() != b.size()) return false;
+  for (size_t ndx = 0; ndx < a.size(); ++ndx)
+    if (details::fold_lower(a[ndx]) != details::fold_lower(b[ndx]))
+      return false;
+  return true;
+}
+
+// As the single-value `locate`, but under ASCII case folding.
+template<npos_choice npv = npos_choice::npos>
+[[nodiscard]] constexpr position locate_nocase(std::string_view s,
+    const SingleLocateValue auto& value, position pos = 0) noexcept {
+  if constexpr (Char<decltype(value)>) {
+    if (!std::is_constant_evaluated())
+      return as_npos<npv>(s, details::locate_byte_nocase(s, value, pos));
+    const auto folded = details::fold_lower(value);
+    for (; pos < s.size(); ++pos)
+      if (details::fold_lower(s[pos]) == folded) return pos;
+    return as_npos<npv>(s, npos);
+  } else {
+    const auto v = std::string_view{value};
+    if (v.empty()) return as_npos<npv>(s, pos <= s.size() ? pos : npos);
+    while (pos + v.size() <= s.size()) {
+      // Scan for a first-byte candidate, then verify the rest.
+      if (!std::is_constant_evaluated()) {
+        pos = details::locate_byte_nocase(s, v.front(), pos);
+        if (pos == npos || pos + v.size() > s.size()) break;
+      } else {
+        const auto folded = details::fold_lower(v.front());
+        while (pos + v.size() <= s.size() &&
+               details::fold_lower(s[pos]) != folded)
+          ++pos;
+        if (pos + v.size() > s.size()) break;
+      }
+      if (equal_nocase(s.substr(pos, v.size()), v)) return pos;
+      ++pos;
+    }
+    return as_npos<npv>(s, npos);
+  }
+}
+
+// As the single-value `located`, but under ASCII case folding.
+template<npos_choice npv = npos_choice::npos>
+constexpr bool located_nocase(position& pos, std::string_view s,
+    const SingleLocateValue auto& value) noexcept {
+  return (pos = locate_nocase<npv>(s, value, pos)) != as_npos<npv>(s);
+}
+
+// As the single-value `substitute`, but matching `from` under ASCII case
+// folding. The replacement is inserted as given; only the match is folded.
+size_t substitute_nocase(std::string& s, SingleLocateValue auto from,
+    SingleLocateValue auto to, position pos = 0) noexcept {
+  size_t cnt{};
+  if constexpr (Char<decltype(from)>) {
+    static_assert(Char<decltype(to)>, "from/to must match");
+    for (; located_nocase(pos, s, from); ++cnt, ++pos) s[pos] = to;
+  } else {
+    static_assert(!Char<decltype(to)>, "from/to must match");
+    const auto from_sv = std::string_view{from};
+    const auto to_sv = std::string_view{to};
+    // An empty `from` matches the same places regardless of case.
+    if (from_sv.empty()) return substitute(s, from_sv, to_sv, pos);
+    const auto from_size = from_sv.size();
+    if (from_size != to_sv.size()) {
+      // Same single-allocation strategy as `substitute`: count the matches,
+      // then build the result with one allocation and one forward pass.
+      for (auto at = pos; located_nocase(at, s, from_sv); ++cnt)
+        at += from_size;
+      if (!cnt) return cnt;
+      std::string result;
+      result.reserve(s.size() - cnt * from_size + cnt * to_sv.size());
+      size_t prev = 0;
+      for (auto at = pos; located_nocase(at, s, from_sv); prev = at) {
+        result.append(s, prev, at - prev);
+        result.append(to_sv);
+        at += from_size;
+      }
+      result.append(s, prev, npos);
+      s = std::move(result);
+      return cnt;
+    }
+    for (; located_nocase(pos, s, from_sv); ++cnt, pos += from_size)
+      s.replace(pos, from_size, to_sv);
+  }
+  return cnt;
+}
+
 //
 // Excise
 //
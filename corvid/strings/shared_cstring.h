@@ -0,0 +1,213 @@
+// Corvid20: A general-purpose C++20 library extending std.
+// https://github.com/stevensudit/Corvid20
+//
+// Copyright 2022-2024 Steven Sudit
+//
+// Licensed under the Apache License, Version 2.0(the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <new>
+#include <utility>
+
+#include "cstring_view.h"
+
+namespace corvid {
+inline namespace sharedcstring {
+
+// Immutable, atomically refcounted string.
+//
+// The owning counterpart to `cstring_view`: a single allocation holds the
+// refcount, the length, and the terminated bytes, so constructing from a
+// `std::string_view` costs one allocation and one copy, and every further
+// copy of the `shared_cstring` costs one atomic increment. This is the
+// cheap way to fan a message payload out to N consumers, as opposed to
+// handing each a deep copy or a view with a fragile lifetime contract.
+//
+// Because the bytes are immutable and the count is atomic, distinct
+// instances sharing one payload may be read, copied, and destroyed from
+// different threads freely; only mutating a single instance from two
+// threads at once requires outside synchronization, the same contract as
+// `std::shared_ptr`.
+//
+// Conversion to `cstring_view` or `std::string_view` is free and
+// constant-time, but the view is only valid while some instance keeps the
+// payload alive. As with `cstring_view`, a default-constructed value is
+// null, which is distinct from owning an empty string; construction from a
+// null `std::string_view` or `nullptr` preserves nullness.
+class shared_cstring {
+public:
+  using value_type = char;
+  using size_type = size_t;
+
+  constexpr shared_cstring() noexcept = default;
+  constexpr shared_cstring(std::nullptr_t) noexcept {}
+
+  // Construct by copying the bytes, once.
+  explicit shared_cstring(std::string_view sv) : header_{make(sv)} {}
+
+  shared_cstring(const shared_cstring& other) noexcept
+      : header_{other.header_} {
+    retain(header_);
+  }
+  shared_cstring(shared_cstring&& other) noexcept
+      : header_{std::exchange(other.header_, nullptr)} {}
+
+  shared_cstring& operator=(const shared_cstring& other) noexcept {
+    shared_cstring{other}.swap(*this);
+    return *this;
+  }
+  shared_cstring& operator=(shared_cstring&& other) noexcept {
+    shared_cstring{std::move(other)}.swap(*this);
+    return *this;
+  }
+
+  ~shared_cstring() { release(header_); }
+
+  void swap(shared_cstring& other) noexcept {
+    std::swap(header_, other.header_);
+  }
+
+  // Drop this reference, becoming null.
+  void reset() noexcept { release(std::exchange(header_, nullptr)); }
+
+  //
+  // Access
+  //
+
+  [[nodiscard]] size_type size() const noexcept {
+    return header_ ? header_->size : 0;
+  }
+  [[nodiscard]] size_type length() const noexcept { return size(); }
+  [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+  // Whether `data` is `nullptr`.
+  [[nodiscard]] bool null() const noexcept { return !header_; }
+  explicit operator bool() const noexcept { return !null(); }
+
+  [[nodiscard]] const char* data() const noexcept {
+    return header_ ? chars() : nullptr;
+  }
+
+  // Pointer to terminated string; never `nullptr`.
+  [[nodiscard]] const char* c_str() const noexcept {
+    return header_ ? chars() : "";
+  }
+
+  // Conversions to views, which borrow rather than share: they are valid
+  // only while some instance keeps the payload alive.
+  [[nodiscard]] std::string_view view() const noexcept {
+    return header_ ? std::string_view{chars(), header_->size}
+                   : std::string_view{};
+  }
+  operator std::string_view() const noexcept { return view(); }
+
+  [[nodiscard]] cstring_view cview() const noexcept {
+    return header_ ? cstring_view{chars(), header_->size + 1}
+                   : cstring_view{};
+  }
+  operator cstring_view() const noexcept { return cview(); }
+
+  // Number of instances sharing the payload. As with `std::shared_ptr`,
+  // this is a snapshot, reliable only when it returns 1 on the sole owner.
+  [[nodiscard]] size_t use_count() const noexcept {
+    return header_ ? header_->refs.load(std::memory_order_relaxed) : 0;
+  }
+
+  //
+  // Comparison
+  //
+
+  // As with `cstring_view`, empty and null compare as equivalent; use
+  // `same` to distinguish them, or `shares` to test for payload identity.
+  friend auto operator<=>(const shared_cstring& l,
+      const shared_cstring& r) noexcept {
+    return l.view() <=> r.view();
+  }
+  friend bool operator==(const shared_cstring& l,
+      const shared_cstring& r) noexcept {
+    return l.view() == r.view();
+  }
+  friend auto operator<=>(const shared_cstring& l,
+      const std::string_view& rv) noexcept {
+    return l.view() <=> rv;
+  }
+  friend bool operator==(const shared_cstring& l,
+      const std::string_view& rv) noexcept {
+    return l.view() == rv;
+  }
+
+  [[nodiscard]] bool same(const shared_cstring& other) const noexcept {
+    return *this == other && null() == other.null();
+  }
+  [[nodiscard]] bool shares(const shared_cstring& other) const noexcept {
+    return header_ == other.header_;
+  }
+
+  friend std::ostream& operator<<(std::ostream& os,
+      const shared_cstring& ss) {
+    return os << ss.view();
+  }
+
+private:
+  // The bytes follow the header in the same allocation, terminated.
+  struct header_t {
+    std::atomic<size_t> refs;
+    size_t size;
+  };
+
+  header_t* header_{};
+
+  const char* chars() const noexcept {
+    return reinterpret_cast<const char*>(header_ + 1);
+  }
+
+  static header_t* make(std::string_view sv) {
+    // Preserve nullness instead of allocating an empty payload.
+    if (!sv.data()) return nullptr;
+    auto* h =
+        static_cast<header_t*>(::operator new(sizeof(header_t) + sv.size() + 1));
+    new (h) header_t{{1}, sv.size()};
+    auto* p = reinterpret_cast<char*>(h + 1);
+    std::copy_n(sv.data(), sv.size(), p);
+    p[sv.size()] = '\0';
+    return h;
+  }
+
+  // The increment can be relaxed because the new reference is always
+  // derived from an existing one; the decrement must acquire/release so
+  // that all reads of the payload happen-before its deletion.
+  static void retain(header_t* h) noexcept {
+    if (h) h->refs.fetch_add(1, std::memory_order_relaxed);
+  }
+  static void release(header_t* h) noexcept {
+    if (h && h->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      h->~header_t();
+      ::operator delete(h);
+    }
+  }
+};
+
+} // namespace sharedcstring
+} // namespace corvid
+
+template<>
+struct std::hash<corvid::shared_cstring> {
+  using is_transparent = void;
+  size_t operator()(const corvid::shared_cstring& ss) const noexcept {
+    return std::hash<std::string_view>{}(ss.view());
+  }
+  size_t operator()(std::string_view sv) const noexcept {
+    return std::hash<std::string_view>{}(sv);
+  }
+};
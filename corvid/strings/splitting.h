@@ -15,6 +15,9 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 #pragma once
+#include <array>
+#include <iterator>
+
 #include "strings_shared.h"
 #include "delimiting.h"
 #include "opt_string_view.h"
@@ -74,6 +77,92 @@ template<typename R = std::string_view>
   return split<std::string>(std::string_view(whole), d);
 }
 
+// Split `whole` into exactly `K` pieces by delimiters, returning them in a
+// `std::array` of `std::string_view`, so parsing a fixed-schema record is
+// allocation-free and the field count is fixed at compile time.
+//
+// Does not omit empty pieces. Returns an empty optional when the input does
+// not have exactly `K` pieces. Fully constexpr-capable.
+template<size_t K>
+[[nodiscard]] constexpr std::optional<std::array<std::string_view, K>>
+split_fixed(std::string_view whole, delim d = {}) {
+  static_assert(K != 0);
+  std::array<std::string_view, K> parts;
+  std::string_view part;
+  size_t cnt = 0;
+  for (bool more = !whole.empty(); more;) {
+    more = more_pieces(part, whole, d);
+    if (cnt == K) return std::nullopt;
+    parts[cnt++] = part;
+  }
+  if (cnt != K) return std::nullopt;
+  return parts;
+}
+
+// Lazy, non-allocating alternative to `split`.
+//
+// Yields exactly the pieces that `split` would return, in order, as
+// `std::string_view` values produced on demand, so splitting a large input
+// costs no allocations and no more scanning than is consumed. Works with
+// range-based for and range adaptors.
+//
+// The pieces are views into `whole`, so the range must not outlive the
+// characters it was constructed over.
+//
+// Usage:
+//   for (auto piece : split_range("1,2,3", ",")) ...
+class split_range {
+public:
+  constexpr split_range() = default;
+  constexpr explicit split_range(std::string_view whole, delim d = {})
+      : whole_{whole}, delim_{d} {}
+
+  class iterator {
+  public:
+    using value_type = std::string_view;
+    using difference_type = std::ptrdiff_t;
+
+    constexpr iterator() = default;
+    constexpr iterator(std::string_view whole, delim d)
+        : whole_{whole}, delim_{d}, done_{whole.empty()} {
+      if (!done_) more_ = more_pieces(part_, whole_, delim_);
+    }
+
+    constexpr value_type operator*() const noexcept { return part_; }
+
+    constexpr iterator& operator++() {
+      if (more_)
+        more_ = more_pieces(part_, whole_, delim_);
+      else
+        done_ = true;
+      return *this;
+    }
+    constexpr void operator++(int) { ++*this; }
+
+    constexpr bool operator==(std::default_sentinel_t) const noexcept {
+      return done_;
+    }
+
+  private:
+    std::string_view whole_;
+    delim delim_;
+    std::string_view part_;
+    bool more_{};
+    bool done_ = true;
+  };
+
+  [[nodiscard]] constexpr iterator begin() const noexcept {
+    return {whole_, delim_};
+  }
+  [[nodiscard]] constexpr std::default_sentinel_t end() const noexcept {
+    return {};
+  }
+
+private:
+  std::string_view whole_;
+  delim delim_;
+};
+
 // Concept to detect whether a type is a piece_generator.
 //
 // This requires it to be moveable, be constructable from `std::string_view`,
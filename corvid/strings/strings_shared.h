@@ -18,6 +18,7 @@
 #include <algorithm>
 #include <cassert>
 #include <charconv>
+#include <cstdint>
 #include <cstdlib>
 #include <concepts>
 #include <functional>
@@ -31,10 +32,53 @@
 #include <optional>
 
 #include "../meta.h"
+#include "fixed_string.h"
 
 namespace corvid::strings {
 
 // Import.
 using namespace std::literals;
 
+inline namespace hashing {
+
+// Seed for `hash_string`; the FNV-1a offset basis.
+inline constexpr uint64_t hash_string_seed = 0xcbf2'9ce4'8422'2325ull;
+
+// Constexpr FNV-1a string hash. Quality is fine for dispatch and
+// compile-time use; for hash tables, prefer `fast_hash` from
+// `containers/transparent.h`.
+constexpr uint64_t hash_string(std::string_view sv,
+    uint64_t seed = hash_string_seed) noexcept {
+  uint64_t h = seed;
+  for (const char c : sv) {
+    h ^= static_cast<unsigned char>(c);
+    h *= 0x0000'0100'0000'01b3ull;
+  }
+  return h;
+}
+
+// Switch-on-string dispatch: hash the subject once, switch on integer case
+// labels built from `fixed_string` template arguments, and verify the one
+// surviving candidate with a single compare:
+//
+//   switch (switch_hash(key)) {
+//   case switch_hash<"content-length">():
+//     if (key == "content-length") { ... }
+//     break;
+//   ...
+//
+// The verify-compare guards against a hash collision at runtime; case
+// labels that collide with each other fail to compile, since case values
+// must be unique.
+[[nodiscard]] constexpr uint64_t switch_hash(std::string_view sv) noexcept {
+  return hash_string(sv);
+}
+
+// Case-label counterpart, forced to compile time.
+template<fixed_string S>
+[[nodiscard]] consteval uint64_t switch_hash() noexcept {
+  return hash_string(S.view());
+}
+
+} // namespace hashing
 } // namespace corvid::strings
@@ -15,8 +15,19 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 #pragma once
+#include <span>
+#include <utility>
+
 #include "strings_shared.h"
 
+#if __has_include(<sys/uio.h>)
+#define CORVID_HAS_WRITEV
+#include <sys/uio.h>
+#include <unistd.h>
+#include <cerrno>
+#include <memory>
+#endif
+
 namespace corvid::strings { inline namespace targeting {
 
 //
@@ -103,6 +114,228 @@ private:
   }
 };
 
+//
+// Append buffer
+//
+
+// A reusable append target backed by a single page-aligned allocation,
+// intended for serialization loops that would otherwise churn a scratch
+// `std::string` per iteration or pin a large one per thread. Build into it
+// with `concat`, `append_join`, and the rest, hand the contents off as a
+// `string_view` or `span` (e.g. to `write`) without copying, then `clear`
+// and go again.
+//
+// Capacity is retained across `clear` calls, so steady-state appends never
+// allocate. To keep one oversized message from pinning memory forever, the
+// buffer tracks the peak size over a window of `shrink_interval` clears and
+// releases the backing when capacity is more than four times that peak;
+// since the buffer is empty at that point, the shrink is just a free.
+class append_buffer {
+public:
+  using is_append_target_t = void;
+  static constexpr size_t page_size = 4096;
+  static constexpr size_t shrink_interval = 64;
+
+  append_buffer() = default;
+  explicit append_buffer(size_t capacity) { reserve(capacity); }
+  append_buffer(const append_buffer&) = delete;
+  append_buffer& operator=(const append_buffer&) = delete;
+  ~append_buffer() { release(); }
+
+  auto& append(std::string_view sv) {
+    ensure(sv.size());
+    std::copy_n(sv.data(), sv.size(), data_ + size_);
+    size_ += sv.size();
+    return *this;
+  }
+  auto& append(size_t len, char ch) {
+    ensure(len);
+    std::fill_n(data_ + size_, len, ch);
+    size_ += len;
+    return *this;
+  }
+
+  void reserve(size_t capacity) {
+    if (capacity > capacity_) grow(capacity);
+  }
+
+  // Empty the buffer, keeping (and occasionally shrinking) the capacity.
+  void clear() {
+    if (size_ > peak_) peak_ = size_;
+    size_ = 0;
+    if (++clears_ != shrink_interval) return;
+    clears_ = 0;
+    const auto peak = std::exchange(peak_, size_t{});
+    if (capacity_ > 4 * std::max(peak, page_size)) release();
+  }
+
+  [[nodiscard]] const char* data() const noexcept { return data_; }
+  [[nodiscard]] size_t size() const noexcept { return size_; }
+  [[nodiscard]] size_t capacity() const noexcept { return capacity_; }
+  [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+
+  [[nodiscard]] std::string_view view() const noexcept {
+    return {data_, size_};
+  }
+  [[nodiscard]] operator std::string_view() const noexcept { return view(); }
+  [[nodiscard]] std::span<const char> span() const noexcept {
+    return {data_, size_};
+  }
+
+private:
+  void ensure(size_t len) {
+    if (capacity_ - size_ < len) grow(size_ + len);
+  }
+
+  // Grow to at least `needed`, doubling and rounding up to whole pages.
+  void grow(size_t needed) {
+    auto new_capacity = std::max(needed, 2 * capacity_);
+    new_capacity = (new_capacity + page_size - 1) / page_size * page_size;
+    const auto new_data = static_cast<char*>(
+        ::operator new(new_capacity, std::align_val_t{page_size}));
+    if (size_) std::copy_n(data_, size_, new_data);
+    release();
+    data_ = new_data;
+    capacity_ = new_capacity;
+  }
+
+  void release() noexcept {
+    if (data_) ::operator delete(data_, std::align_val_t{page_size});
+    data_ = nullptr;
+    capacity_ = 0;
+  }
+
+  char* data_{};
+  size_t size_{};
+  size_t capacity_{};
+  size_t peak_{};
+  size_t clears_{};
+};
+
+#ifdef CORVID_HAS_WRITEV
+
+//
+// File descriptor sink
+//
+
+// An append target that buffers parts in fixed-size chunks and flushes them
+// to a file descriptor (typically a socket) with a single gathered `writev`
+// call, so serializing through `concat` or `join` doesn't need an
+// intermediate `std::string` or pay `std::ostream` overhead per part.
+//
+// Parts are copied once into the chunk chain; the chain itself is never
+// coalesced, so a flush costs one syscall (or a few, past `IOV_MAX`).
+//
+// Flushing happens on `flush` and on destruction; the latter is best-effort,
+// so call `flush` and check `ok` when you care about errors. The sink does
+// not own the descriptor and never closes it.
+class fd_sink {
+public:
+  using is_append_target_t = void;
+  static constexpr size_t chunk_size = 4096;
+
+  explicit fd_sink(int fd) : fd_{fd} {}
+  fd_sink(const fd_sink&) = delete;
+  fd_sink& operator=(const fd_sink&) = delete;
+  ~fd_sink() { flush(); }
+
+  auto& append(std::string_view sv) {
+    while (!sv.empty()) {
+      auto& c = back_chunk();
+      const auto len = std::min(sv.size(), chunk_size - c.used);
+      std::copy_n(sv.data(), len, c.data + c.used);
+      c.used += len;
+      sv.remove_prefix(len);
+    }
+    return *this;
+  }
+  auto& append(size_t len, char ch) {
+    while (len) {
+      auto& c = back_chunk();
+      const auto n = std::min(len, chunk_size - c.used);
+      std::fill_n(c.data + c.used, n, ch);
+      c.used += n;
+      len -= n;
+    }
+    return *this;
+  }
+
+  // Write all pending chunks out, returning success. Retries on partial
+  // writes and `EINTR`; any other error latches `ok` false and drops the
+  // pending data.
+  bool flush() {
+    std::vector<iovec> iov;
+    iov.reserve(chunks_.size());
+    for (auto& c : chunks_)
+      if (c->used) iov.push_back({c->data, c->used});
+    for (size_t at = 0; at != iov.size();) {
+      const auto cnt = std::min(iov.size() - at, size_t{IOV_MAX});
+      auto written = ::writev(fd_, iov.data() + at, static_cast<int>(cnt));
+      if (written < 0) {
+        if (errno == EINTR) continue;
+        failed_ = true;
+        break;
+      }
+      // Skip whole iovecs, then trim the one written partially.
+      while (written > 0 && static_cast<size_t>(written) >= iov[at].iov_len)
+        written -= static_cast<ssize_t>(iov[at++].iov_len);
+      if (written > 0) {
+        iov[at].iov_base = static_cast<char*>(iov[at].iov_base) + written;
+        iov[at].iov_len -= static_cast<size_t>(written);
+      }
+    }
+    chunks_.clear();
+    return !failed_;
+  }
+
+  [[nodiscard]] size_t pending() const {
+    size_t total = 0;
+    for (auto& c : chunks_) total += c->used;
+    return total;
+  }
+
+  [[nodiscard]] int fd() const { return fd_; }
+  [[nodiscard]] bool ok() const { return !failed_; }
+
+private:
+  struct chunk {
+    char data[chunk_size];
+    size_t used{};
+  };
+
+  chunk& back_chunk() {
+    if (chunks_.empty() || chunks_.back()->used == chunk_size)
+      chunks_.push_back(std::make_unique<chunk>());
+    return *chunks_.back();
+  }
+
+  int fd_;
+  bool failed_{};
+  std::vector<std::unique_ptr<chunk>> chunks_;
+};
+
+#endif // CORVID_HAS_WRITEV
+
+// Dedicated target specialization, forwarding to the target's own `append`
+// overloads. This covers `fd_sink` and anything else that declares itself
+// with `is_append_target_t`.
+template<DedicatedAppendTarget T>
+class appender<T>: public appender_crtp<T> {
+public:
+  explicit appender(T& target) : appender_crtp<T>{target} {}
+
+private:
+  friend appender_crtp<T>;
+  auto& append_sv(std::string_view sv) {
+    appender_crtp<T>::target_.append(sv);
+    return *this;
+  }
+  auto& append_ch(size_t len, char ch) {
+    appender_crtp<T>::target_.append(len, ch);
+    return *this;
+  }
+};
+
 // Deduction guide.
 template<AppendTarget T>
 appender(T) -> appender<T>;
@@ -20,6 +20,37 @@
 
 namespace corvid::strings { inline namespace trimming {
 
+namespace details {
+
+// Length of the run of `ch` at the front of `whole`, skipping a word at a
+// time while all eight lanes match and finishing off byte by byte. Padded
+// fields routinely lead with dozens of repeats of the same character, so the
+// word test pays for itself quickly.
+[[nodiscard]] inline size_t leading_run(std::string_view whole,
+    char ch) noexcept {
+  size_t pos = 0;
+  const auto needle = locating::details::swar_broadcast(ch);
+  while (pos + 8 <= whole.size() &&
+         (locating::details::swar_load(whole.data() + pos) ^ needle) == 0)
+    pos += 8;
+  while (pos != whole.size() && whole[pos] == ch) ++pos;
+  return pos;
+}
+
+// Size of `whole` once the trailing run of `ch` is dropped.
+[[nodiscard]] inline size_t without_trailing_run(std::string_view whole,
+    char ch) noexcept {
+  auto len = whole.size();
+  const auto needle = locating::details::swar_broadcast(ch);
+  while (len >= 8 &&
+         (locating::details::swar_load(whole.data() + len - 8) ^ needle) == 0)
+    len -= 8;
+  while (len && whole[len - 1] == ch) --len;
+  return len;
+}
+
+} // namespace details
+
 //
 // Trim
 //
@@ -30,6 +61,8 @@ namespace corvid::strings { inline namespace trimming {
 // Trim whitespace on left, returning part.
 template<typename R = std::string_view>
 [[nodiscard]] constexpr auto trim_left(std::string_view whole, delim ws = {}) {
+  if (!std::is_constant_evaluated() && ws.size() == 1)
+    return R{whole.substr(details::leading_run(whole, ws.front()))};
   auto pos = ws.find_not_in(whole);
   std::string_view part;
   if (pos != part.npos) part = whole.substr(pos);
@@ -40,6 +73,8 @@ template<typename R = std::string_view>
 template<typename R = std::string_view>
 [[nodiscard]] constexpr auto
 trim_right(std::string_view whole, delim ws = {}) {
+  if (!std::is_constant_evaluated() && ws.size() == 1)
+    return R{whole.substr(0, details::without_trailing_run(whole, ws.front()))};
   auto pos = ws.find_last_not_in(whole);
   auto part = whole.substr(0, pos + 1);
   return R{part};
@@ -1,3 +1,7 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdlib>
 #include <iostream>
 #include <sstream>
 
@@ -30,6 +34,41 @@ auto inline stream_to_text(const auto& v) {
   return os.str();
 }
 
+// Budget multiplier for `EXPECT_FASTER_THAN`, from the
+// `CORVID_PERF_TOLERANCE` environment variable. Slow or noisy CI machines
+// set it above 1 so that perf budgets guard against real regressions
+// without flaking; setting it to 0 skips the timing checks entirely.
+inline double perf_tolerance() {
+  static const double tolerance = [] {
+    if (const char* env = std::getenv("CORVID_PERF_TOLERANCE")) {
+      char* end{};
+      if (const auto v = std::strtod(env, &end); end != env && v >= 0)
+        return v;
+    }
+    return 1.0;
+  }();
+  return tolerance;
+}
+
+// Time `iterations` calls of `fn`, several runs after a warmup run, and
+// return the median so a scheduler hiccup in one run doesn't fail the check.
+template<typename FN>
+std::chrono::nanoseconds perf_median(size_t iterations, FN&& fn) {
+  using clock = std::chrono::steady_clock;
+  constexpr size_t runs = 5;
+  std::array<std::chrono::nanoseconds, runs> samples{};
+  for (size_t run = 0; run <= runs; ++run) {
+    const auto start = clock::now();
+    for (size_t i = 0; i < iterations; ++i) fn();
+    const auto elapsed = clock::now() - start;
+    // The zeroth run is warmup and isn't sampled.
+    if (run) samples[run - 1] = elapsed;
+  }
+  std::nth_element(samples.begin(), samples.begin() + runs / 2,
+      samples.end());
+  return samples[runs / 2];
+}
+
 } // namespace accutest_shim
 
 #define VALUE_MSG(actual, expected)                                           \
@@ -162,25 +201,53 @@ auto inline stream_to_text(const auto& v) {
 
 #define EXPECT_THROW(call, exc) TEST_EXCEPTION((void)(call), exc)
 
+// Check that `iterations` calls of the lambda fit in `budget` (a `chrono`
+// duration), measured as the median of several runs after warmup. The
+// budget is scaled by `CORVID_PERF_TOLERANCE` (see `perf_tolerance`), and a
+// tolerance of 0 skips the check. The lambda is the last parameter so that
+// its body may contain commas.
+#define EXPECT_FASTER_THAN(budget, iterations, ...)                           \
+  do {                                                                        \
+    const double tolerance_ = accutest_shim::perf_tolerance();                \
+    if (tolerance_ == 0) break;                                               \
+    const auto budget_ =                                                      \
+        std::chrono::duration_cast<std::chrono::nanoseconds>(budget);         \
+    const auto allowed_ = std::chrono::nanoseconds{                           \
+        static_cast<long long>(budget_.count() * tolerance_)};                \
+    const auto median_ =                                                      \
+        accutest_shim::perf_median((iterations), __VA_ARGS__);                \
+    TEST_CHECK_((median_ <= allowed_), "%s",                                  \
+        ("(" #iterations " iterations within " #budget ")"));                 \
+    TEST_MSG("Median:  `%lld ns`", (long long)median_.count());               \
+    TEST_MSG("Allowed: `%lld ns`", (long long)allowed_.count());              \
+    TEST_MSG("File: %s Line: %d Function: %s", __FILE__, __LINE__,            \
+        __FUNCTION__);                                                        \
+  } while (false);
+
 #if defined(__GNUC__) || defined(__clang__)
 // Supports 0-10 arguments
 #define VA_NARGS_IMPL(_0, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12,  \
     _13, _14, _15, _16, _17, _18, _19, _20, _21, _22, _23, _24, _25, _26,     \
-    _27, _28, _29, _30, N, ...)                                               \
+    _27, _28, _29, _30, _31, _32, _33, _34, _35, _36, _37, _38, _39, _40,     \
+    _41, _42, _43, _44, _45, _46, _47, _48, _49, _50, N, ...)                  \
   N
 // ## deletes preceding comma if _VA_ARGS__ is empty (GCC, Clang)
 #define VA_NARGS(...)                                                         \
-  VA_NARGS_IMPL(_, ##__VA_ARGS__, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, \
-      19, 18, 17, 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0)
+  VA_NARGS_IMPL(_, ##__VA_ARGS__, 50, 49, 48, 47, 46, 45, 44, 43, 42, 41, 40, \
+      39, 38, 37, 36, 35, 34, 33, 32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, \
+      21, 20, 19, 18, 17, 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, \
+      1, 0)
 #else
 // Supports 1-10 arguments
 #define VA_NARGS_IMPL(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, \
     _14, _15, _16, _17, _18, _19, _20, _21, _22, _23, _24, _25, _26, _27,     \
-    _28, _29, _30, N, ...)                                                    \
+    _28, _29, _30, _31, _32, _33, _34, _35, _36, _37, _38, _39, _40, _41,     \
+    _42, _43, _44, _45, _46, _47, _48, _49, _50, N, ...)                       \
   N
 #define VA_NARGS(...)                                                         \
-  VA_NARGS_IMPL(__VA_ARGS__, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19,  \
-      18, 17, 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1)
+  VA_NARGS_IMPL(__VA_ARGS__, 50, 49, 48, 47, 46, 45, 44, 43, 42, 41, 40, 39,  \
+      38, 37, 36, 35, 34, 33, 32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, \
+      20, 19, 18, 17, 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1)
 #endif
 
 #define VA_NARGS2(...) ((int)(sizeof((int[]){__VA_ARGS__}) / sizeof(int)))
@@ -216,6 +283,27 @@ auto inline stream_to_text(const auto& v) {
 #define TEST_LIST_IMPL_28(x, ...) {#x, x}, TEST_LIST_IMPL_27(__VA_ARGS__)
 #define TEST_LIST_IMPL_29(x, ...) {#x, x}, TEST_LIST_IMPL_28(__VA_ARGS__)
 #define TEST_LIST_IMPL_30(x, ...) {#x, x}, TEST_LIST_IMPL_29(__VA_ARGS__)
+#define TEST_LIST_IMPL_31(x, ...) {#x, x}, TEST_LIST_IMPL_30(__VA_ARGS__)
+#define TEST_LIST_IMPL_32(x, ...) {#x, x}, TEST_LIST_IMPL_31(__VA_ARGS__)
+#define TEST_LIST_IMPL_33(x, ...) {#x, x}, TEST_LIST_IMPL_32(__VA_ARGS__)
+#define TEST_LIST_IMPL_34(x, ...) {#x, x}, TEST_LIST_IMPL_33(__VA_ARGS__)
+#define TEST_LIST_IMPL_35(x, ...) {#x, x}, TEST_LIST_IMPL_34(__VA_ARGS__)
+#define TEST_LIST_IMPL_36(x, ...) {#x, x}, TEST_LIST_IMPL_35(__VA_ARGS__)
+#define TEST_LIST_IMPL_37(x, ...) {#x, x}, TEST_LIST_IMPL_36(__VA_ARGS__)
+#define TEST_LIST_IMPL_38(x, ...) {#x, x}, TEST_LIST_IMPL_37(__VA_ARGS__)
+#define TEST_LIST_IMPL_39(x, ...) {#x, x}, TEST_LIST_IMPL_38(__VA_ARGS__)
+#define TEST_LIST_IMPL_40(x, ...) {#x, x}, TEST_LIST_IMPL_39(__VA_ARGS__)
+
+#define TEST_LIST_IMPL_41(x, ...) {#x, x}, TEST_LIST_IMPL_40(__VA_ARGS__)
+#define TEST_LIST_IMPL_42(x, ...) {#x, x}, TEST_LIST_IMPL_41(__VA_ARGS__)
+#define TEST_LIST_IMPL_43(x, ...) {#x, x}, TEST_LIST_IMPL_42(__VA_ARGS__)
+#define TEST_LIST_IMPL_44(x, ...) {#x, x}, TEST_LIST_IMPL_43(__VA_ARGS__)
+#define TEST_LIST_IMPL_45(x, ...) {#x, x}, TEST_LIST_IMPL_44(__VA_ARGS__)
+#define TEST_LIST_IMPL_46(x, ...) {#x, x}, TEST_LIST_IMPL_45(__VA_ARGS__)
+#define TEST_LIST_IMPL_47(x, ...) {#x, x}, TEST_LIST_IMPL_46(__VA_ARGS__)
+#define TEST_LIST_IMPL_48(x, ...) {#x, x}, TEST_LIST_IMPL_47(__VA_ARGS__)
+#define TEST_LIST_IMPL_49(x, ...) {#x, x}, TEST_LIST_IMPL_48(__VA_ARGS__)
+#define TEST_LIST_IMPL_50(x, ...) {#x, x}, TEST_LIST_IMPL_49(__VA_ARGS__)
 
 #define TEST_LIST_IMPL_N(N, ...) TEST_LIST_IMPL_##N(__VA_ARGS__)
 #define TEST_LIST_IMPL(N, ...) TEST_LIST_IMPL_N(N, __VA_ARGS__)
@@ -293,6 +293,14 @@ constexpr auto registry::enum_spec_v<patchy_rgb> =
 
 void BitMaskTest_MoreNamingTests() {
   using namespace strings;
+  if (true) {
+    // The fully-named rgb spec precomputes its whole-mask renderings; the
+    // unnamed one cannot.
+    static_assert(registry::enum_spec_v<rgb>.cache_renderings_v);
+    static_assert(!registry::enum_spec_v<rgb_unnamed>.cache_renderings_v);
+    EXPECT_EQ(enum_as_string(rgb::yellow), "red + green");
+    EXPECT_EQ(enum_as_string(rgb::white), "red + green + blue");
+  }
   if (true) {
     EXPECT_EQ(valid_bits_v<rgb_unnamed>, 7);
     EXPECT_EQ(max_value<rgb_unnamed>(), rgb_unnamed::white);
@@ -784,6 +792,39 @@ void BitMaskTest_ExtractEnum() {
 
 // TODO: Add tests for op~ and flip for bit masks with holes.
 
+void BitMaskTest_SetBits() {
+  if (true) {
+    EXPECT_EQ(flag_count(rgb::black), 0u);
+    EXPECT_EQ(flag_count(rgb::red), 1u);
+    EXPECT_EQ(flag_count(rgb::yellow), 2u);
+    EXPECT_EQ(flag_count(rgb::white), 3u);
+  }
+  if (true) {
+    auto bits = set_bits(rgb::white);
+    EXPECT_EQ(bits.size(), 3u);
+    EXPECT_FALSE(bits.empty());
+    std::vector<rgb> v{bits.begin(), bits.end()};
+    EXPECT_EQ(v, (std::vector{rgb::blue, rgb::green, rgb::red}));
+  }
+  if (true) {
+    std::vector<rgb> v;
+    for (auto bit : set_bits(rgb::purple)) v.push_back(bit);
+    EXPECT_EQ(v, (std::vector{rgb::blue, rgb::red}));
+
+    v.clear();
+    for (auto bit : set_bits(rgb::black)) v.push_back(bit);
+    EXPECT_TRUE(v.empty());
+    EXPECT_TRUE(set_bits(rgb::black).empty());
+    EXPECT_EQ(set_bits(rgb::black).size(), 0u);
+  }
+  if (true) {
+    // Compile-time friendly.
+    static_assert(flag_count(rgb::cyan) == 2);
+    constexpr auto first = *set_bits(rgb::cyan).begin();
+    static_assert(first == rgb::blue);
+  }
+}
+
 MAKE_TEST_LIST(BitMaskTest_Ops, BitMaskTest_NamedFunctions,
     BitMaskTest_SafeOps, BitMaskTest_SafeNamedFunctions,
     BitMaskTest_MoreNamingTests, BitMaskTest_StreamingOut, BitMaskTest_NoGreen,
@@ -791,4 +832,4 @@ MAKE_TEST_LIST(BitMaskTest_Ops, BitMaskTest_NamedFunctions,
     BitMaskTest_SafeNoBlue, BitMaskTest_SafeNoRed, BitMaskTest_SkipBlue,
     BitMaskTest_SafeBlackWhite, BitMaskTest_EnumCalcBitNames,
     BitMaskTest_EnumCalcValueNames, BitMaskTest_SafeWhite,
-    BitMaskTest_ExtractEnum);
+    BitMaskTest_ExtractEnum, BitMaskTest_SetBits);
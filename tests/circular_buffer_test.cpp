@@ -17,6 +17,7 @@
 
 #include <cstdint>
 #include <string_view>
+#include <thread>
 
 #include "../corvid/containers.h"
 #include "AccutestShim.h"
@@ -528,6 +529,184 @@ void CircularBufferTest_Smoke() {
   }
 }
 
+void CircularBufferTest_Bulk() {
+  std::vector<int> v;
+  v.resize(5);
+  circular_buffer cb{v};
+
+  // Fill partially, then bulk-push across the wrap point.
+  cb.push_back(1);
+  cb.push_back(2);
+  EXPECT_EQ(cb.pop_front(), 1);
+  const std::array<int, 4> in{3, 4, 5, 6};
+  EXPECT_EQ(cb.push_back_bulk(in), 4u);
+  EXPECT_EQ(cb.size(), 5u);
+  EXPECT_TRUE(cb.full());
+  // No room left, so nothing is pushed and nothing is overwritten.
+  EXPECT_EQ(cb.push_back_bulk(in), 0u);
+  EXPECT_EQ(cb[0], 2);
+  EXPECT_EQ(cb[4], 6);
+
+  // The contents show up as two contiguous spans, front to back.
+  auto spans = cb.peek_spans();
+  EXPECT_EQ(spans[0].size() + spans[1].size(), 5u);
+  EXPECT_EQ(spans[0][0], 2);
+  std::vector<int> seen;
+  for (const auto& span : spans)
+    seen.insert(seen.end(), span.begin(), span.end());
+  EXPECT_EQ(seen, (std::vector<int>{2, 3, 4, 5, 6}));
+
+  // Bulk pop copies in order and frees the room.
+  std::array<int, 3> out{};
+  EXPECT_EQ(cb.pop_front_bulk(out), 3u);
+  EXPECT_EQ(out, (std::array<int, 3>{2, 3, 4}));
+  EXPECT_EQ(cb.size(), 2u);
+
+  // Dropping without copying, as after draining via peek_spans.
+  EXPECT_EQ(cb.pop_front_bulk(cb.size()), 2u);
+  EXPECT_TRUE(cb.empty());
+  EXPECT_EQ(cb.pop_front_bulk(std::span<int>{out}), 0u);
+  EXPECT_TRUE(cb.peek_spans()[0].empty());
+}
+
+void CircularBufferTest_Pow2() {
+  std::vector<int> v;
+  v.resize(8);
+  pow2_circular_buffer<int> cb{v};
+  EXPECT_EQ(cb.capacity(), 8u);
+
+  // Wrapping is a bitmask instead of a modulo, but behaves identically.
+  for (int i = 0; i < 6; ++i) cb.push_back(i);
+  for (int i = 0; i < 4; ++i) EXPECT_EQ(cb.pop_front(), i);
+  const std::array<int, 5> in{6, 7, 8, 9, 10};
+  EXPECT_EQ(cb.push_back_bulk(in), 5u);
+  EXPECT_EQ(cb.size(), 7u);
+  for (int i = 0; i < 7; ++i) EXPECT_EQ(cb[i], i + 4);
+  EXPECT_EQ(cb.pop_front_bulk(3u), 3u);
+  EXPECT_EQ(cb.front(), 7);
+  EXPECT_EQ(cb.back(), 10);
+
+  // The spsc variant takes the same flag.
+  pow2_spsc_circular_buffer<int> scb{v};
+  EXPECT_EQ(scb.capacity(), 7u);
+  EXPECT_TRUE(scb.try_push(42));
+  int out{};
+  EXPECT_TRUE(scb.try_pop(out));
+  EXPECT_EQ(out, 42);
+}
+
+void SpscCircularBufferTest_Ops() {
+  if (true) {
+    std::vector<int> v;
+    v.resize(4);
+    spsc_circular_buffer cb{v};
+    EXPECT_TRUE(cb.empty());
+    EXPECT_EQ(cb.capacity(), 3u);
+
+    // One slot is sacrificed, so it fills at capacity, not size.
+    EXPECT_TRUE(cb.try_push(1));
+    EXPECT_TRUE(cb.try_push(2));
+    EXPECT_TRUE(cb.try_emplace(3));
+    EXPECT_TRUE(cb.full());
+    EXPECT_FALSE(cb.try_push(4));
+    EXPECT_EQ(cb.size(), 3u);
+
+    // FIFO, and wrapping reopens room.
+    int out{};
+    EXPECT_TRUE(cb.try_pop(out));
+    EXPECT_EQ(out, 1);
+    EXPECT_TRUE(cb.try_push(4));
+    EXPECT_TRUE(cb.try_pop(out));
+    EXPECT_EQ(out, 2);
+    EXPECT_TRUE(cb.try_pop(out));
+    EXPECT_EQ(out, 3);
+    EXPECT_TRUE(cb.try_pop(out));
+    EXPECT_EQ(out, 4);
+    EXPECT_FALSE(cb.try_pop(out));
+    EXPECT_TRUE(cb.empty());
+  }
+}
+
+void SpscCircularBufferTest_Threads() {
+  constexpr int count = 100'000;
+  std::array<int, 64> storage{};
+  spsc_circular_buffer cb{storage};
+
+  std::int64_t total{};
+  std::thread consumer{[&] {
+    int received = 0;
+    int value{};
+    while (received != count)
+      if (cb.try_pop(value)) {
+        total += value;
+        ++received;
+      }
+  }};
+  for (int i = 1; i <= count;)
+    if (cb.try_push(i)) ++i;
+  consumer.join();
+  EXPECT_EQ(total, std::int64_t{count} * (count + 1) / 2);
+}
+
+void MpscCircularBufferTest_Ops() {
+  std::vector<mpsc_circular_buffer<int>::slot> storage{4};
+  mpsc_circular_buffer<int> cb{storage};
+  EXPECT_TRUE(cb.empty());
+
+  // No slot is sacrificed; the sequences distinguish full from empty.
+  EXPECT_EQ(cb.capacity(), 4u);
+  EXPECT_TRUE(cb.try_push(1));
+  EXPECT_TRUE(cb.try_push(2));
+  EXPECT_TRUE(cb.try_emplace(3));
+  EXPECT_TRUE(cb.try_push(4));
+  EXPECT_TRUE(cb.full());
+  EXPECT_FALSE(cb.try_push(5));
+  EXPECT_EQ(cb.size(), 4u);
+
+  // FIFO, and wrapping reopens room.
+  int out{};
+  EXPECT_TRUE(cb.try_pop(out));
+  EXPECT_EQ(out, 1);
+  EXPECT_TRUE(cb.try_push(5));
+  for (int i = 2; i <= 5; ++i) {
+    EXPECT_TRUE(cb.try_pop(out));
+    EXPECT_EQ(out, i);
+  }
+  EXPECT_FALSE(cb.try_pop(out));
+  EXPECT_TRUE(cb.empty());
+}
+
+void MpscCircularBufferTest_Threads() {
+  constexpr int count = 50'000;
+  constexpr int producers = 4;
+  std::vector<mpsc_circular_buffer<int>::slot> storage{64};
+  mpsc_circular_buffer<int> cb{storage};
+
+  std::int64_t total{};
+  std::thread consumer{[&] {
+    int received = 0;
+    int value{};
+    while (received != count * producers)
+      if (cb.try_pop(value)) {
+        total += value;
+        ++received;
+      }
+  }};
+  std::vector<std::thread> workers;
+  for (int w = 0; w < producers; ++w)
+    workers.emplace_back([&] {
+      for (int i = 1; i <= count;)
+        if (cb.try_push(i)) ++i;
+    });
+  for (auto& worker : workers) worker.join();
+  consumer.join();
+  EXPECT_EQ(total,
+      std::int64_t{producers} * (std::int64_t{count} * (count + 1) / 2));
+}
+
 MAKE_TEST_LIST(CircularBufferTest_Construction, CircularBufferTest_WrapIndex,
     CircularBufferTest_Ops, CircularBufferTest_PushPop,
-    CircularBufferTest_Iterate, CircularBufferTest_Smoke);
+    CircularBufferTest_Iterate, CircularBufferTest_Smoke,
+    CircularBufferTest_Bulk, CircularBufferTest_Pow2, SpscCircularBufferTest_Ops,
+    SpscCircularBufferTest_Threads, MpscCircularBufferTest_Ops,
+    MpscCircularBufferTest_Threads);
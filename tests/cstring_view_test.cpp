@@ -20,7 +20,10 @@
 #include <set>
 #include <span>
 
+#include <unordered_map>
+
 #include "../corvid/strings/cstring_view.h"
+#include "../corvid/strings/shared_cstring.h"
 #include "../corvid/meta.h"
 #include "AccutestShim.h"
 
@@ -423,5 +426,56 @@ void CStringViewTest_Env() {
   EXPECT_TRUE(missing.null());
 }
 
+void SharedCstringTest_Basic() {
+  // Null and empty are distinct, as with `cstring_view`.
+  shared_cstring n;
+  EXPECT_TRUE(n.null());
+  EXPECT_TRUE(n.empty());
+  EXPECT_FALSE(n);
+  EXPECT_TRUE(n.data() == nullptr);
+  EXPECT_EQ(*n.c_str(), '\0');
+  shared_cstring e{""sv};
+  EXPECT_FALSE(e.null());
+  EXPECT_TRUE(e.empty());
+  EXPECT_EQ(n, e);
+  EXPECT_FALSE(n.same(e));
+  EXPECT_TRUE(shared_cstring{std::string_view{}}.null());
+
+  // One allocation, one copy; views and c_str borrow it.
+  shared_cstring ss{"abc"sv};
+  EXPECT_EQ(ss.size(), 3u);
+  EXPECT_EQ(ss.view(), "abc");
+  EXPECT_EQ(ss.cview(), "abc"_csv);
+  EXPECT_EQ(ss.c_str()[3], '\0');
+  EXPECT_EQ(ss, "abc"sv);
+  EXPECT_LT(ss.view(), "abd"sv);
+
+  // Copies share the payload; the last one out frees it.
+  EXPECT_EQ(ss.use_count(), 1u);
+  auto ss2 = ss;
+  EXPECT_EQ(ss.use_count(), 2u);
+  EXPECT_TRUE(ss2.shares(ss));
+  EXPECT_TRUE(ss2.same(ss));
+  EXPECT_TRUE(ss2.data() == ss.data());
+  auto ss3 = std::move(ss2);
+  EXPECT_TRUE(ss2.null());
+  EXPECT_EQ(ss.use_count(), 2u);
+  ss3.reset();
+  EXPECT_EQ(ss.use_count(), 1u);
+
+  // Equal contents in separate payloads compare equal but share nothing.
+  shared_cstring other{"abc"sv};
+  EXPECT_EQ(other, ss);
+  EXPECT_FALSE(other.shares(ss));
+
+  // Usable as a transparent hash key.
+  std::unordered_map<shared_cstring, int, std::hash<shared_cstring>,
+      std::equal_to<>>
+      m;
+  m.emplace(ss, 42);
+  EXPECT_EQ(m.find(shared_cstring{"abc"sv})->second, 42);
+}
+
 MAKE_TEST_LIST(CStringViewTest_Construction, CStringViewTest_Optional,
-    CStringViewTest_Cast, CStringViewTestEqual, CStringViewTest_Env);
+    CStringViewTest_Cast, CStringViewTestEqual, CStringViewTest_Env,
+    SharedCstringTest_Basic);
@@ -70,4 +70,26 @@ void FixedStringTest_General() {
   EXPECT_EQ(ceval, "abc"_csv);
 }
 
-MAKE_TEST_LIST(FixedStringTest_General);
+void FixedStringTest_ConstexprConcatJoin() {
+  // Concatenation and joining resolve entirely at compile time.
+  constexpr auto cat = strings::constexpr_concat<"abc", "def", "gh">();
+  static_assert(cat.view() == "abcdefgh"sv);
+  EXPECT_EQ(cat.view(), "abcdefgh"sv);
+  EXPECT_EQ(cat.cview(), "abcdefgh"_csv);
+  constexpr auto joined = strings::constexpr_join<", ", "a", "b", "c">();
+  static_assert(joined.view() == "a, b, c"sv);
+  EXPECT_EQ(joined.view(), "a, b, c"sv);
+  // Degenerate cases.
+  static_assert(strings::constexpr_concat<>().view() == ""sv);
+  static_assert(strings::constexpr_concat<"only">().view() == "only"sv);
+  static_assert(strings::constexpr_join<",">().view() == ""sv);
+  static_assert(strings::constexpr_join<",", "x">().view() == "x"sv);
+  static_assert(strings::constexpr_join<"", "x", "y">().view() == "xy"sv);
+  // The result is itself NTTP-capable.
+  constexpr auto sql =
+      GetFixedString<strings::constexpr_join<" ", "SELECT", "*", "FROM",
+          "t">()>();
+  EXPECT_EQ(sql, "SELECT * FROM t"sv);
+}
+
+MAKE_TEST_LIST(FixedStringTest_General, FixedStringTest_ConstexprConcatJoin);
@@ -0,0 +1,124 @@
+// Corvid20: A general-purpose C++20 library extending std.
+// https://github.com/stevensudit/Corvid20
+//
+// Copyright 2022-2024 Steven Sudit
+//
+// Licensed under the Apache License, Version 2.0(the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// The whole point is to test the enabled configuration.
+#define CORVID_INSTRUMENT
+
+#include <thread>
+
+#include "../corvid/instrument.h"
+#include "../corvid/containers/arena_allocator.h"
+#include "../corvid/containers/timers.h"
+
+#include "AccutestShim.h"
+
+using namespace std::literals;
+using namespace std::chrono;
+using namespace std::chrono_literals;
+using namespace corvid;
+using namespace corvid::container::arena;
+
+void InstrumentTest_Counter() {
+  counter c;
+  EXPECT_EQ(c.read(), 0u);
+  c.add();
+  c.add(41);
+  EXPECT_EQ(c.read(), 42u);
+
+  // Increments from other threads land in their own shards but sum on read.
+  constexpr size_t threads = 4;
+  constexpr uint64_t per_thread = 10'000;
+  std::vector<std::thread> workers;
+  for (size_t t = 0; t < threads; ++t)
+    workers.emplace_back([&c] {
+      for (uint64_t i = 0; i < per_thread; ++i) c.add();
+    });
+  for (auto& w : workers) w.join();
+  EXPECT_EQ(c.read(), 42u + threads * per_thread);
+
+  std::string s;
+  c.append_to(s);
+  EXPECT_EQ(s, "40042");
+}
+
+void InstrumentTest_Histogram() {
+  // Bucket math: 0 is alone, then powers of two.
+  static_assert(histogram::bucket_of(0) == 0);
+  static_assert(histogram::bucket_of(1) == 1);
+  static_assert(histogram::bucket_of(2) == 2);
+  static_assert(histogram::bucket_of(3) == 2);
+  static_assert(histogram::bucket_of(4) == 3);
+  static_assert(histogram::bucket_min(2) == 2);
+  static_assert(histogram::bucket_max(2) == 3);
+  static_assert(histogram::bucket_min(8) == 128);
+  static_assert(histogram::bucket_max(8) == 255);
+  static_assert(histogram::bucket_max(64) == ~uint64_t{});
+
+  histogram h;
+  EXPECT_EQ(h.count(), 0u);
+  h.record(0);
+  h.record(1);
+  h.record(2);
+  h.record(3);
+  h.record(200);
+  const auto c = h.counts();
+  EXPECT_EQ(c[0], 1u);
+  EXPECT_EQ(c[1], 1u);
+  EXPECT_EQ(c[2], 2u);
+  EXPECT_EQ(c[8], 1u);
+  EXPECT_EQ(h.count(), 5u);
+
+  std::string s;
+  h.append_to(s);
+  EXPECT_EQ(s, "{0-0: 1, 1-1: 1, 2-3: 2, 128-255: 1}");
+
+  // Cross-thread records aggregate the same way counters do.
+  std::thread{[&h] { h.record(3); }}.join();
+  const auto c2 = h.counts();
+  EXPECT_EQ(c2[2], 3u);
+}
+
+void InstrumentTest_Hooks() {
+  // Arena allocations land in the size histogram.
+  const auto allocs = metrics::arena_alloc_bytes.count();
+  extensible_arena arena{4096};
+  extensible_arena::scope s{arena};
+  (void)extensible_arena::allocate(100, 8);
+  (void)extensible_arena::allocate(10, 8);
+  EXPECT_EQ(metrics::arena_alloc_bytes.count(), allocs + 2);
+
+  // Timer callbacks bump the fire counter.
+  const auto fires = metrics::timer_fires.read();
+  timers_ns::timers t;
+  auto now = steady_clock::now();
+  t.set_clock_callback([&now] { return now; });
+  size_t called{};
+  (void)t.set(1ms, [&called](auto&) { ++called; });
+  now += 2ms;
+  EXPECT_EQ(t.tick(), 1u);
+  EXPECT_EQ(called, 1u);
+  EXPECT_EQ(metrics::timer_fires.read(), fires + 1);
+
+  // The report renders one line per metric.
+  std::string report;
+  metrics::append_report(report);
+  EXPECT_TRUE(report.find("timer_fires: ") != std::string::npos);
+  EXPECT_TRUE(report.find("arena_alloc_bytes: {") != std::string::npos);
+}
+
+MAKE_TEST_LIST(InstrumentTest_Counter, InstrumentTest_Histogram,
+    InstrumentTest_Hooks);
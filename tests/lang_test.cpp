@@ -33,7 +33,10 @@ template<operation op, typename... Args>
 
 void LangTest_AstPred() {
   using enum operation;
-  node_ptr root;
+  // All nodes go into the arena and are freed as a unit when it goes away.
+  extensible_arena arena{16384};
+  extensible_arena::scope s{arena};
+  node_ptr root{};
   if (true) {
   }
   if (true) {
@@ -77,7 +80,7 @@ void LangTest_AstPred() {
   }
   if (true) {
     // Negations of terminals.
-    node_ptr root;
+    node_ptr root{};
 
     // Negating a true should yield a false.
     root = M<not_junction>(M<always_true>());
@@ -418,4 +421,177 @@ void LangTest_AstPred() {
   }
 }
 
-MAKE_TEST_LIST(LangTest_AstPred);
+void LangTest_AstPredCompile() {
+  using enum operation;
+  extensible_arena arena{16384};
+  extensible_arena::scope s{arena};
+
+  // A record to evaluate against.
+  map_lookup lk;
+  lk.m["color"] = any_single_value{arena_string{"red"}};
+  lk.m["count"] = 42;
+
+  if (true) {
+    // Constant programs.
+    auto p = program::compile(M<always_true>());
+    EXPECT_TRUE(p.eval(lk));
+    p = program::compile(M<always_false>());
+    EXPECT_FALSE(p.eval(lk));
+  }
+  if (true) {
+    // Single leaves.
+    EXPECT_TRUE(program::compile(M<exists>("color"s)).eval(lk));
+    EXPECT_FALSE(program::compile(M<exists>("shape"s)).eval(lk));
+    EXPECT_FALSE(program::compile(M<absent>("color"s)).eval(lk));
+    EXPECT_TRUE(program::compile(M<absent>("shape"s)).eval(lk));
+    EXPECT_TRUE(program::compile(M<eq>("count"s, 42)).eval(lk));
+    EXPECT_FALSE(program::compile(M<eq>("count"s, 43)).eval(lk));
+    EXPECT_TRUE(program::compile(M<ne>("count"s, 43)).eval(lk));
+    // Missing keys fail both eq and ne.
+    EXPECT_FALSE(program::compile(M<eq>("shape"s, 42)).eval(lk));
+    EXPECT_FALSE(program::compile(M<ne>("shape"s, 42)).eval(lk));
+  }
+  if (true) {
+    // Clauses: DNF of (exists(color) AND eq(count, 42)) OR exists(shape).
+    auto root = dnf::convert(M<or_junction>(
+        M<and_junction>(M<exists>("color"s), M<eq>("count"s, 42)),
+        M<exists>("shape"s)));
+    auto p = program::compile(root);
+    EXPECT_TRUE(p.eval(lk));
+
+    // Keys are deduplicated, in first-use order.
+    EXPECT_EQ(p.keys().size(), 3u);
+    EXPECT_EQ(p.keys()[0], "color");
+    EXPECT_EQ(p.keys()[1], "count");
+    EXPECT_EQ(p.keys()[2], "shape");
+
+    // Pre-resolved evaluation through the span overload.
+    std::vector<const any_value*> values;
+    for (const auto& k : p.keys()) values.push_back(&lk[k]);
+    EXPECT_TRUE(p.eval(values));
+
+    // Fails once the record changes.
+    lk.m["count"] = 7;
+    EXPECT_FALSE(p.eval(lk));
+    lk.m["shape"] = any_single_value{arena_string{"square"}};
+    EXPECT_TRUE(p.eval(lk));
+    lk.m["count"] = 42;
+  }
+  if (true) {
+    // The program owns its storage, so it survives its source tree's arena.
+    program p = [] {
+      extensible_arena tree_arena{4096};
+      extensible_arena::scope inner{tree_arena};
+      return program::compile(
+          dnf::convert(M<and_junction>(M<exists>("color"s),
+              M<not_junction>(M<eq>("count"s, 43)))));
+    }();
+    EXPECT_TRUE(p.eval(lk));
+  }
+}
+
+void LangTest_AstPredBatch() {
+  using enum operation;
+  extensible_arena arena{65536};
+  extensible_arena::scope s{arena};
+
+  // (color == "red" AND exists(shape)) OR count == 5, against 70 rows so
+  // the bitmap crosses a word boundary.
+  any_value red{any_single_value{arena_string{"red"}}};
+  auto root = dnf::convert(
+      M<or_junction>(M<and_junction>(M<eq>("color"s, red), M<exists>("shape"s)),
+          M<eq>("count"s, 5)));
+  auto p = program::compile(root);
+  EXPECT_EQ(p.keys().size(), 3u);
+
+  constexpr size_t rows = 70;
+  std::vector<any_value> colors(rows), counts(rows), shapes(rows);
+  for (size_t r = 0; r < rows; ++r) {
+    colors[r] =
+        any_single_value{arena_string{r % 3 == 0 ? "red" : "blue"}};
+    counts[r] = static_cast<int64_t>(r % 7);
+    // Rows not divisible by 5 leave shape missing.
+    if (r % 5 == 0) shapes[r] = any_single_value{arena_string{"square"}};
+  }
+
+  // Build the columns in key order.
+  std::vector<std::vector<const any_value*>> cols;
+  for (const auto& k : p.keys()) {
+    const auto& src = k == "color" ? colors : k == "count" ? counts : shapes;
+    auto& col = cols.emplace_back();
+    for (const auto& v : src) col.push_back(&v);
+  }
+  std::vector<program::value_column> columns{cols.begin(), cols.end()};
+
+  std::vector<uint64_t> bm(program::bitmap_words(rows));
+  p.eval_batch(rows, columns, bm);
+
+  // Every bit matches row-at-a-time evaluation.
+  for (size_t r = 0; r < rows; ++r) {
+    std::vector<const any_value*> values;
+    for (const auto& col : cols) values.push_back(col[r]);
+    const bool expected = p.eval(values);
+    EXPECT_EQ(((bm[r / 64] >> (r % 64)) & 1) != 0, expected);
+    EXPECT_EQ(expected, (r % 3 == 0 && r % 5 == 0) || r % 7 == 5);
+  }
+  // Bits past the last row stay clear.
+  EXPECT_EQ(bm.back() >> (rows % 64), 0u);
+
+  // Constant programs need no columns.
+  auto always = program::compile(M<always_true>());
+  always.eval_batch(rows, {}, bm);
+  EXPECT_EQ(bm[0], ~uint64_t{});
+  EXPECT_EQ(bm[1], (uint64_t{1} << (rows % 64)) - 1);
+}
+
+void LangTest_AstPredDedupe() {
+  using enum operation;
+  extensible_arena arena{65536};
+  extensible_arena::scope s{arena};
+  node_ptr root{};
+
+  if (true) {
+    // Idempotence: duplicate terms in a junction collapse.
+    root = dnf::convert(M<and_junction>(M<exists>("A"s), M<exists>("A"s)));
+    EXPECT_EQ((root->print()), "exists:(A)");
+    root = dnf::convert(M<or_junction>(M<exists>("A"s), M<exists>("A"s)));
+    EXPECT_EQ((root->print()), "exists:(A)");
+  }
+  if (true) {
+    // Structurally identical subtrees intern to the same node, so the
+    // classic blowup case (X AND X, for OR-valued X) collapses outright.
+    root = dnf::convert(M<and_junction>(
+        M<or_junction>(M<exists>("A"s), M<exists>("B"s)),
+        M<or_junction>(M<exists>("A"s), M<exists>("B"s))));
+    EXPECT_EQ((root->print()), "or:(exists:(A), exists:(B))");
+  }
+  if (true) {
+    // Double negation shares the original leaf.
+    root = dnf::convert(M<or_junction>(M<exists>("A"s),
+        M<not_junction>(M<not_junction>(M<exists>("A"s)))));
+    EXPECT_EQ((root->print()), "exists:(A)");
+  }
+  if (true) {
+    // De Morgan over duplicated terms collapses to a single negation.
+    root = dnf::convert(
+        M<not_junction>(M<or_junction>(M<exists>("A"s), M<exists>("A"s))));
+    EXPECT_EQ((root->print()), "absent:(A)");
+  }
+  if (true) {
+    // A leaf repeated across clauses is pooled into one test.
+    root = dnf::convert(M<or_junction>(
+        M<and_junction>(M<exists>("A"s), M<exists>("B"s)),
+        M<and_junction>(M<exists>("A"s), M<exists>("C"s))));
+    auto p = program::compile(root);
+    EXPECT_EQ(p.test_count(), 3u);
+
+    map_lookup lk;
+    lk.m["A"] = 1;
+    EXPECT_FALSE(p.eval(lk));
+    lk.m["C"] = 2;
+    EXPECT_TRUE(p.eval(lk));
+  }
+}
+
+MAKE_TEST_LIST(LangTest_AstPred, LangTest_AstPredCompile, LangTest_AstPredBatch,
+    LangTest_AstPredDedupe);
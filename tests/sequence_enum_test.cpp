@@ -539,6 +539,14 @@ void SequentialEnumTest_ExtractEnum() {
     sv = "miny ; ";
     e = parse_enum(sv, tiger_pick::moe);
     EXPECT_EQ(e, tiger_pick::moe);
+
+    // Near-misses against the frozen lookup table: same length as a real
+    // name, a prefix, and an overlong variant.
+    EXPECT_FALSE(parse_enum<tiger_pick>("mini").has_value());
+    EXPECT_FALSE(parse_enum<tiger_pick>("min").has_value());
+    EXPECT_FALSE(parse_enum<tiger_pick>("minyy").has_value());
+    opte = parse_enum<tiger_pick>("moe");
+    EXPECT_EQ(opte.value(), tiger_pick::moe);
   }
   if (true) {
     e10_13 e{};
@@ -15,6 +15,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <cmath>
 #include <cstdint>
 #include <map>
 #include <set>
@@ -114,6 +115,24 @@ void StringUtilsTest_Split() {
     EXPECT_EQ(strings::split(s, ","), (V{"1", "2", "3", "4"}));
     EXPECT_EQ(strings::split(std::move(s), ","), (S{"1", "2", "3", "4"}));
   }
+  if (true) {
+    // Fixed-field split: exactly K pieces or nothing.
+    using A = std::array<std::string_view, 3>;
+    auto fields = strings::split_fixed<3>("1,2,3"sv, ",");
+    EXPECT_TRUE(fields.has_value());
+    EXPECT_EQ(*fields, (A{"1", "2", "3"}));
+    fields = strings::split_fixed<3>("1,,3"sv, ",");
+    EXPECT_EQ(*fields, (A{"1", "", "3"}));
+    fields = strings::split_fixed<3>(",,"sv, ",");
+    EXPECT_EQ(*fields, (A{"", "", ""}));
+    EXPECT_FALSE(strings::split_fixed<3>("1,2"sv, ","));
+    EXPECT_FALSE(strings::split_fixed<3>("1,2,3,4"sv, ","));
+    EXPECT_FALSE(strings::split_fixed<3>(""sv, ","));
+    const auto single = strings::split_fixed<1>("1"sv, ",");
+    EXPECT_EQ((*single)[0], "1");
+    static_assert(
+        (*strings::split_fixed<2>("a b"sv))[1] == "b");
+  }
   if (true) {
     using R = std::string;
     using V = std::vector<R>;
@@ -121,6 +140,27 @@ void StringUtilsTest_Split() {
     EXPECT_EQ(strings::split<R>("11,22,33", ","), (V{"11", "22", "33"}));
     EXPECT_EQ(strings::split<R>(R{"11,22,33"}, ","), (V{"11", "22", "33"}));
   }
+  if (true) {
+    // split_range yields the same pieces as split, lazily.
+    using V = std::vector<std::string_view>;
+    auto collect = [](std::string_view whole, strings::delim d = {}) {
+      V parts;
+      for (auto piece : strings::split_range(whole, d))
+        parts.push_back(piece);
+      return parts;
+    };
+    EXPECT_EQ(collect(""sv, ","), (V{}));
+    EXPECT_EQ(collect("1"sv, ","), (V{"1"}));
+    EXPECT_EQ(collect("1,"sv, ","), (V{"1", ""}));
+    EXPECT_EQ(collect(",1"sv, ","), (V{"", "1"}));
+    EXPECT_EQ(collect(",,"sv, ","), (V{"", "", ""}));
+    EXPECT_EQ(collect("11,22,33"sv, ","), (V{"11", "22", "33"}));
+    EXPECT_EQ(collect("1 2"sv), (V{"1", "2"}));
+    // It's a real input range, usable with adaptors.
+    static_assert(std::ranges::input_range<strings::split_range>);
+    auto sr = strings::split_range("11,22,33"sv, ",");
+    EXPECT_EQ(std::ranges::distance(sr), 3);
+  }
 }
 
 void StringUtilsTest_SplitPg() {
@@ -193,6 +233,14 @@ void StringUtilsTest_Case() {
   char a[] = "abcdefghij";
   strings::to_upper(a);
   EXPECT_EQ(a, "ABCDEFGHIJ"sv);
+  // Only ASCII letters are converted, including by the word-at-a-time path;
+  // neighbors of the letter ranges and high bytes pass through untouched.
+  EXPECT_EQ(strings::as_upper("@az[`Az{ \x80\xe9\xff mixedCASE123"),
+      "@AZ[`AZ{ \x80\xe9\xff MIXEDCASE123");
+  EXPECT_EQ(strings::as_lower("@AZ[`aZ{ \x80\xc9\xff MIXEDcase123"),
+      "@az[`az{ \x80\xc9\xff mixedcase123");
+  EXPECT_EQ(strings::as_upper(""), "");
+  EXPECT_EQ(strings::as_upper("abcdefg"), "ABCDEFG");
 }
 
 template<typename T>
@@ -537,9 +585,82 @@ void StringUtilsTest_Locate() {
     EXPECT_EQ(strings::count_located(s, a0), 0u);
     const auto s0 = std::span<const std::string_view>{a0};
     EXPECT_EQ(strings::count_located(s, s0), 0u);
+    // The SWAR counting kernel must stay exact when a match is adjacent to a
+    // byte one greater ('b' before 'c' would trip an inexact zero test).
+    EXPECT_EQ(strings::count_located("bcbcbcbcbcbc"sv, 'b'), 6u);
+    EXPECT_EQ(strings::count_located("bcbcbcbcbcbc"sv, 'c'), 6u);
+    static_assert(strings::count_located("bcbcbcbcbcbc"sv, 'b') == 6u);
+    // Counts spanning word boundaries, offsets, and ragged tails.
+    const auto line = std::string(129, 'x') + "\n" + std::string(63, 'y');
+    auto lines = line + line + line;
+    EXPECT_EQ(strings::count_located(lines, '\n'), 3u);
+    EXPECT_EQ(strings::count_located(lines, '\n', 130), 2u);
+    EXPECT_EQ(strings::count_located(lines, 'x'), 3u * 129);
+    // Char sets, including duplicated values, count each position once.
+    EXPECT_EQ(strings::count_located(lines, {'\n', 'y'}), 3u + 3u * 63);
+    EXPECT_EQ(strings::count_located(lines, {'\n', '\n'}), 3u);
+    const auto big_set = std::array{'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h',
+        'i', '\n'};
+    EXPECT_EQ(strings::count_located(lines, std::span<const char>{big_set}),
+        3u);
     EXPECT_EQ(strings::count_located(s, {""sv}), 24u);
     EXPECT_EQ(strings::count_located(s, {""}), 24u);
   }
+  if (true) {
+    // Multi-char locate over targets long enough to engage the word-at-a-time
+    // kernel, including matches in the unaligned tail and value lists large
+    // enough to use the bitmap path.
+    const auto s = std::string(100, '-') + "q" + std::string(6, '-') + "z";
+    EXPECT_EQ(strings::locate(s, {'x', 'q', 'y'}), (location{100u, 1u}));
+    EXPECT_EQ(strings::locate(s, {'x', 'z', 'y'}), (location{107u, 1u}));
+    EXPECT_EQ(strings::locate(s, {'x', 'q', 'y'}, 101u), nloc);
+    EXPECT_EQ(strings::locate(s, {'x', 'z', 'y'}, 101u), (location{107u, 1u}));
+    const auto many = std::array{'0', '1', '2', '3', '4', '5', '6', '7', '8',
+        'q'};
+    EXPECT_EQ(strings::locate(s, std::span<const char>{many}),
+        (location{100u, 9u}));
+    EXPECT_EQ(strings::count_located(s, {'q', 'z'}), 2u);
+    EXPECT_EQ(strings::locate(s, std::span<const char>{}), nloc);
+  }
+}
+
+void StringUtilsTest_CompiledLocator() {
+  using location = corvid::strings::location;
+  constexpr auto s = "abcdefghijabxdefghij"sv;
+  // Same results as the free function, amortized over calls.
+  const auto cl = strings::compiled_locator{{"a0c"sv, "def"sv, "g0i"sv}};
+  EXPECT_EQ(cl.size(), 3u);
+  EXPECT_EQ(cl.locate(s), (location{3u, 1u}));
+  EXPECT_EQ(cl.locate(s, 4u), (location{13u, 1u}));
+  EXPECT_EQ(cl.locate(s, 14u), nloc);
+  EXPECT_EQ(cl.locate(s, npos), nloc);
+  // Leftmost match wins, even when a shorter value ends first.
+  const auto overlapping = strings::compiled_locator{{"bcd"sv, "cd"sv}};
+  EXPECT_EQ(overlapping.locate(s), (location{1u, 0u}));
+  // Ties at the same pos go to the lowest pos_value.
+  const auto tied = strings::compiled_locator{{"abc"sv, "ab"sv}};
+  EXPECT_EQ(tied.locate(s), (location{0u, 0u}));
+  EXPECT_EQ(tied.locate(s), strings::locate(s, {"abc"sv, "ab"sv}));
+  // Looping with located and point_past.
+  location loc{};
+  size_t cnt{};
+  while (cl.located(loc, s)) ++cnt, cl.point_past(loc);
+  EXPECT_EQ(cnt, 2u);
+  // Empty values match everywhere, like the free function.
+  const auto empties = strings::compiled_locator{{"x0y"sv, ""sv}};
+  EXPECT_EQ(empties.locate(s), (location{0u, 1u}));
+  EXPECT_EQ(empties.locate(s, s.size()), (location{s.size(), 1u}));
+  // Degenerate locators locate nothing.
+  EXPECT_EQ(strings::compiled_locator{}.locate(s), nloc);
+  const auto none = strings::compiled_locator{
+      std::span<const std::string_view>{}};
+  EXPECT_EQ(none.locate(s), nloc);
+  // The values are copied, so the locator survives its inputs.
+  auto dangling = std::string{"def"};
+  auto copied = strings::compiled_locator{{std::string_view{dangling}}};
+  dangling = "zzz";
+  EXPECT_EQ(copied.locate(s), (location{3u, 0u}));
+  EXPECT_EQ(copied.value(0u), "def"sv);
 }
 
 void StringUtilsTest_RLocate() {
@@ -754,6 +875,29 @@ void StringUtilsTest_Substitute() {
     EXPECT_EQ(s, "xxxdefghij");
     EXPECT_EQ(strings::substituted("abcdef", "abc", "yyy"), "yyydef");
   }
+  if (true) {
+    // Growing and shrinking substitutions, which resize once instead of
+    // once per match, including with a nonzero starting pos.
+    constexpr auto sv = "abcdefghijabcdefghij"sv;
+    auto s = std::string{sv};
+    EXPECT_EQ(strings::substitute(s, "def"sv, "defdef"sv), 2u);
+    EXPECT_EQ(s, "abcdefdefghijabcdefdefghij");
+    s = std::string{sv};
+    EXPECT_EQ(strings::substitute(s, "def"sv, "xxxx"sv, 4u), 1u);
+    EXPECT_EQ(s, "abcdefghijabcxxxxghij");
+    s = std::string{sv};
+    EXPECT_EQ(strings::substitute(s, "def"sv, "x"sv, 4u), 1u);
+    EXPECT_EQ(s, "abcdefghijabcxghij");
+    s = std::string{sv};
+    EXPECT_EQ(strings::substitute(s, {"ab"sv, "gh"sv}, {"ABAB"sv, "G"sv}),
+        4u);
+    EXPECT_EQ(s, "ABABcdefGijABABcdefGij");
+    s = std::string{sv};
+    EXPECT_EQ(strings::substitute(s, {"ab"sv, "gh"sv}, {"ABAB"sv, "G"sv},
+                  10u),
+        2u);
+    EXPECT_EQ(s, "abcdefghijABABcdefGij");
+  }
   if (true) {
     constexpr auto sv = "aaaaaaaaaa"sv;
     auto s = std::string{sv};
@@ -948,6 +1092,46 @@ void StringUtilsTest_Target() {
     EXPECT_EQ(test_append(s, "abc"), "abcaabcaaaa");
     strings::appender(s).reserve(500);
   }
+  if (true) {
+    strings::append_buffer buf;
+    EXPECT_TRUE(buf.empty());
+    EXPECT_EQ(buf.capacity(), 0u);
+    EXPECT_EQ(test_append(buf, "abc").view(), "abcaabcaaaa");
+    EXPECT_EQ(buf.capacity(), strings::append_buffer::page_size);
+    strings::append(buf, "=", 5, ';');
+    strings::append_join_with(buf, ", ", "d", "e");
+    EXPECT_EQ(std::string_view{buf}, "abcaabcaaaa=5;[d, e]");
+    EXPECT_EQ(buf.span().size(), buf.size());
+    // Reuse keeps the capacity; steady state never reallocates.
+    const auto* data = buf.data();
+    buf.clear();
+    EXPECT_TRUE(buf.empty());
+    EXPECT_EQ(buf.capacity(), strings::append_buffer::page_size);
+    strings::append(buf, "again");
+    EXPECT_EQ(buf.view(), "again");
+    EXPECT_TRUE(buf.data() == data);
+    // Growth doubles and rounds up to whole pages, preserving contents.
+    buf.append(8 * strings::append_buffer::page_size, 'x');
+    EXPECT_EQ(buf.view().substr(0, 6), "againx");
+    EXPECT_EQ(buf.size(), 5 + 8 * strings::append_buffer::page_size);
+    EXPECT_EQ(buf.capacity() % strings::append_buffer::page_size, 0u);
+    // An oversized burst is released after a window of small uses.
+    buf.clear();
+    const auto grown = buf.capacity();
+    for (size_t ndx = 0; ndx < 2 * strings::append_buffer::shrink_interval;
+        ++ndx) {
+      strings::append(buf, "tiny");
+      buf.clear();
+    }
+    EXPECT_LT(buf.capacity(), grown);
+    strings::append(buf, "still works");
+    EXPECT_EQ(buf.view(), "still works");
+  }
+  if (true) {
+    strings::append_buffer buf{3 * strings::append_buffer::page_size};
+    EXPECT_EQ(buf.capacity(), 3 * strings::append_buffer::page_size);
+    EXPECT_TRUE(buf.empty());
+  }
 #ifdef NOT_SUPPOSED_TO_COMPILE
   if (true) {
     int i;
@@ -957,6 +1141,46 @@ void StringUtilsTest_Target() {
 #endif
 }
 
+void StringUtilsTest_FdSink() {
+#ifdef CORVID_HAS_WRITEV
+  int fds[2];
+  EXPECT_EQ(::pipe(fds), 0);
+  if (true) {
+    strings::fd_sink sink{fds[1]};
+    EXPECT_EQ(sink.fd(), fds[1]);
+    EXPECT_EQ(sink.pending(), 0u);
+    strings::append(sink, "abc=", 5, ';');
+    strings::append_join_with(sink, ", ", "d", "e");
+    EXPECT_EQ(sink.pending(), 12u);
+    EXPECT_TRUE(sink.flush());
+    EXPECT_EQ(sink.pending(), 0u);
+    // Spill across multiple chunks.
+    sink.append(strings::fd_sink::chunk_size - 1, 'x');
+    strings::append(sink, "yz");
+    EXPECT_EQ(sink.pending(), strings::fd_sink::chunk_size + 1);
+    EXPECT_TRUE(sink.flush());
+    EXPECT_TRUE(sink.ok());
+  }
+  ::close(fds[1]);
+  std::string got(strings::fd_sink::chunk_size + 16, '\0');
+  size_t len = 0;
+  for (ssize_t n;
+      (n = ::read(fds[0], got.data() + len, got.size() - len)) > 0;)
+    len += static_cast<size_t>(n);
+  got.resize(len);
+  EXPECT_EQ(got.substr(0, 12), "abc=5;[d, e]");
+  EXPECT_EQ(got.size(), 12 + strings::fd_sink::chunk_size + 1);
+  EXPECT_EQ(got[12], 'x');
+  EXPECT_EQ(got.substr(got.size() - 2), "yz");
+  ::close(fds[0]);
+  // A sink on a bad descriptor reports the failure.
+  strings::fd_sink bad{-1};
+  bad.append("oops");
+  EXPECT_FALSE(bad.flush());
+  EXPECT_FALSE(bad.ok());
+#endif
+}
+
 struct NotStreamable {};
 
 void StringUtilsTest_Print() {
@@ -1049,6 +1273,23 @@ void StringUtilsTest_Trim() {
     EXPECT_EQ(strings::trim_braces("[12]"), "12");
     EXPECT_EQ(strings::trim_braces("'12'", "'"), "12");
   }
+  if (true) {
+    // Long single-character runs exercise the word-at-a-time fast path.
+    const auto padded = std::string(41, ' ') + "abc" + std::string(23, ' ');
+    EXPECT_EQ(strings::trim_left(padded), "abc" + std::string(23, ' '));
+    EXPECT_EQ(strings::trim_right(padded), std::string(41, ' ') + "abc");
+    EXPECT_EQ(strings::trim(padded), "abc");
+    const auto all_pad = std::string(64, ' ');
+    EXPECT_EQ(strings::trim(all_pad), "");
+    // Runs that are exact word multiples.
+    const auto word_runs = std::string(8, ' ') + "x" + std::string(16, ' ');
+    EXPECT_EQ(strings::trim(word_runs), "x");
+    // Single-character sets other than space.
+    const auto zeros = std::string(30, '0') + "7";
+    EXPECT_EQ(strings::trim(zeros, "0"), "7");
+    // Multi-character sets still go through the bitmap path.
+    EXPECT_EQ(strings::trim("\t \t abc \t ", " \t"), "abc");
+  }
   if (true) {
     auto w = " 1, 2, 3  , 4 "s;
 
@@ -1074,6 +1315,57 @@ void StringUtilsTest_Trim() {
 }
 
 void StringUtilsTest_ParseNum() {
+  if (true) {
+    // The self-contained float parser behind std_from_chars agrees with
+    // std::from_chars, bit for bit, on both easy and hard inputs.
+    auto same_as_std = [](std::string_view in) {
+      double ours{}, theirs{};
+      const auto r = strings::cvt_fix_from_chars::details::fast_from_chars(in.data(),
+          in.data() + in.size(), ours);
+      const auto e =
+          std::from_chars(in.data(), in.data() + in.size(), theirs);
+      if (r.ec != e.ec || r.ptr != e.ptr) return false;
+      if (r.ec != std::errc{}) return true;
+      return ours == theirs || (std::isnan(ours) && std::isnan(theirs));
+    };
+    for (const auto in : {"0"sv, "-0.0"sv, "1"sv, "1.5"sv, "-1.5e10"sv,
+             "2.25"sv, "9.0"sv, "1e22"sv, "1e23"sv, "1e-22"sv, "1e-23"sv,
+             "123456789012345678901234567890.5e-20"sv, "1.7976931348623157e308"sv,
+             "4.9406564584124654e-324"sv, "2.2250738585072011e-308"sv,
+             "1e999"sv, "1e-999"sv, "inf"sv, "-Infinity"sv, "nan"sv, ""sv,
+             "."sv, "-"sv, "e5"sv, "1e"sv, "1.5abc"sv, "0x10"sv,
+             "9007199254740993"sv, "3.141592653589793"sv})
+      EXPECT_TRUE(same_as_std(in));
+    float ourf{};
+    const auto in = "2.5e-9xyz"sv;
+    const auto r = strings::cvt_fix_from_chars::details::fast_from_chars(in.data(),
+        in.data() + in.size(), ourf);
+    EXPECT_EQ(r.ec, std::errc{});
+    EXPECT_EQ(ourf, 2.5e-9f);
+    EXPECT_EQ(r.ptr, in.data() + 6);
+  }
+  if (true) {
+    // parse_nums: fused single-pass parsing of delimited number lists.
+    std::array<double, 8> d{};
+    EXPECT_EQ(strings::parse_nums("1.5,2.25,9.0"sv, std::span{d}, ","), 3u);
+    EXPECT_EQ(d[0], 1.5);
+    EXPECT_EQ(d[1], 2.25);
+    EXPECT_EQ(d[2], 9.0);
+    std::array<int64_t, 3> n{};
+    EXPECT_EQ(strings::parse_nums("10 -20 30 40"sv, std::span{n}), 3u);
+    EXPECT_EQ(n[2], 30);
+    EXPECT_EQ(strings::parse_nums(""sv, std::span{n}, ","), 0u);
+    EXPECT_EQ(strings::parse_nums("1,2,"sv, std::span{n}, ","), 2u);
+    EXPECT_EQ(strings::parse_nums("1,x,3"sv, std::span{n}, ","), 1u);
+    // Leading whitespace before each number is fine; trailing is not.
+    EXPECT_EQ(strings::parse_nums(" 7; 8"sv, std::span{n}, ";"), 2u);
+    EXPECT_EQ(n[0], 7);
+    EXPECT_EQ(n[1], 8);
+    EXPECT_EQ(strings::parse_nums("7 ;8"sv, std::span{n}, ";"), 1u);
+    EXPECT_EQ((strings::parse_nums<16>("ff,10"sv, std::span{n}, ",")), 2u);
+    EXPECT_EQ(n[0], 255);
+    EXPECT_EQ(n[1], 16);
+  }
   if (true) {
     std::string_view sv;
     sv = "123";
@@ -1225,6 +1517,139 @@ void StringUtilsTest_AppendNum() {
         (strings::num_as_string<std::chars_format::general>(double(65536.25))),
         "65536.25");
   }
+  if (true) {
+    // Digit-pair fast path, around the two-digit group boundaries.
+    EXPECT_EQ(strings::num_as_string(9), "9");
+    EXPECT_EQ(strings::num_as_string(10), "10");
+    EXPECT_EQ(strings::num_as_string(99), "99");
+    EXPECT_EQ(strings::num_as_string(100), "100");
+    EXPECT_EQ(strings::num_as_string(12'345), "12345");
+    EXPECT_EQ(strings::num_as_string(-1), "-1");
+    EXPECT_EQ(strings::num_as_string(-12'345), "-12345");
+    EXPECT_EQ(strings::num_as_string(std::numeric_limits<int64_t>::min()),
+        "-9223372036854775808");
+    EXPECT_EQ(strings::num_as_string(std::numeric_limits<uint64_t>::max()),
+        "18446744073709551615");
+    EXPECT_EQ((strings::num_as_string<10, 4, '0'>(42)), "0042");
+    EXPECT_EQ((strings::num_as_string<10, 5>(-42)), "  -42");
+    EXPECT_EQ((strings::num_as_string<10, 4, '0'>(12'345)), "12345");
+  }
+  if (true) {
+    // Fixed-precision fast path for floats: scaled to integer, no to_chars.
+    EXPECT_EQ((strings::num_as_string<2>(1.0)), "1.00");
+    EXPECT_EQ((strings::num_as_string<2>(0.25)), "0.25");
+    EXPECT_EQ((strings::num_as_string<2>(-0.25)), "-0.25");
+    EXPECT_EQ((strings::num_as_string<2>(65536.25)), "65536.25");
+    EXPECT_EQ((strings::num_as_string<2>(1.239)), "1.24");
+    EXPECT_EQ((strings::num_as_string<2>(0.0)), "0.00");
+    EXPECT_EQ((strings::num_as_string<0>(2.5)), "3");
+    EXPECT_EQ((strings::num_as_string<6>(1.5f)), "1.500000");
+    EXPECT_EQ((strings::num_as_string<6>(0.000001)), "0.000001");
+    EXPECT_EQ((strings::num_as_string<2, 8>(1.25)), "    1.25");
+    EXPECT_EQ((strings::num_as_string<2, 8, '0'>(-1.25)), "000-1.25");
+    // Out-of-range magnitudes and non-finite values fall back to to_chars.
+    EXPECT_EQ((strings::num_as_string<2>(1e19)), "10000000000000000000.00");
+    EXPECT_EQ((strings::num_as_string<2>(
+                  std::numeric_limits<double>::infinity())),
+        "inf");
+    EXPECT_EQ((strings::num_as_string<2>(
+                  std::numeric_limits<double>::quiet_NaN())),
+        "nan");
+    std::string s;
+    strings::append_num<2>(s, 3.14159);
+    EXPECT_EQ(s, "3.14");
+  }
+}
+
+void StringUtilsTest_Codecs() {
+  constexpr auto bytes_of = [](std::string_view sv) {
+    return std::as_bytes(std::span{sv});
+  };
+  if (true) {
+    // Hex, both directions.
+    EXPECT_EQ(strings::hex_as_string(bytes_of("")), "");
+    EXPECT_EQ(strings::hex_as_string(bytes_of("\x00\x7f\xff"sv)), "007fff");
+    EXPECT_EQ(strings::hex_as_string(bytes_of("corvid")), "636f72766964");
+
+    std::vector<std::byte> out;
+    auto sv = "636F72766964"sv;
+    EXPECT_TRUE(strings::extract_hex(out, sv));
+    EXPECT_TRUE(sv.empty());
+    EXPECT_EQ(strings::hex_as_string(out), "636f72766964");
+
+    // An unpaired trailing digit is left behind.
+    out.clear();
+    sv = "7fff5,rest"sv;
+    EXPECT_TRUE(strings::extract_hex(out, sv));
+    EXPECT_EQ(sv, "5,rest");
+    EXPECT_EQ(out.size(), 2u);
+
+    sv = "zz"sv;
+    EXPECT_FALSE(strings::extract_hex(out, sv));
+    EXPECT_EQ(sv, "zz");
+  }
+  if (true) {
+    // Base64, against the RFC 4648 vectors.
+    EXPECT_EQ(strings::base64_as_string(bytes_of("")), "");
+    EXPECT_EQ(strings::base64_as_string(bytes_of("f")), "Zg==");
+    EXPECT_EQ(strings::base64_as_string(bytes_of("fo")), "Zm8=");
+    EXPECT_EQ(strings::base64_as_string(bytes_of("foo")), "Zm9v");
+    EXPECT_EQ(strings::base64_as_string(bytes_of("foob")), "Zm9vYg==");
+    EXPECT_EQ(strings::base64_as_string(bytes_of("fooba")), "Zm9vYmE=");
+    EXPECT_EQ(strings::base64_as_string(bytes_of("foobar")), "Zm9vYmFy");
+
+    std::vector<std::byte> out;
+    auto sv = "Zm9vYmE=tail"sv;
+    EXPECT_TRUE(strings::extract_base64(out, sv));
+    EXPECT_EQ(sv, "tail");
+    EXPECT_EQ(strings::hex_as_string(out), "666f6f6261");
+
+    out.clear();
+    sv = "Zm9vYmFy"sv;
+    EXPECT_TRUE(strings::extract_base64(out, sv));
+    EXPECT_TRUE(sv.empty());
+    EXPECT_EQ(out.size(), 6u);
+
+    sv = "Zm9"sv;
+    EXPECT_FALSE(strings::extract_base64(out, sv));
+    EXPECT_EQ(sv, "Zm9");
+  }
+  if (true) {
+    // Round-trip a hash-sized random blob through both codecs.
+    std::vector<std::byte> blob;
+    for (size_t i = 0; i < 32; ++i)
+      blob.push_back(static_cast<std::byte>(i * 37 + 11));
+    auto hex = strings::hex_as_string(blob);
+    EXPECT_EQ(hex.size(), 64u);
+    std::vector<std::byte> back;
+    auto sv = std::string_view{hex};
+    EXPECT_TRUE(strings::extract_hex(back, sv));
+    EXPECT_TRUE(back == blob);
+    auto b64 = strings::base64_as_string(blob);
+    EXPECT_EQ(b64.size(), 44u);
+    back.clear();
+    sv = b64;
+    EXPECT_TRUE(strings::extract_base64(back, sv));
+    EXPECT_TRUE(back == blob);
+  }
+}
+
+void StringUtilsTest_EstimatedSize() {
+  // Exact for strings and chars, a floor for everything else.
+  EXPECT_EQ(strings::estimated_size("abc"sv), 3u);
+  EXPECT_EQ(strings::estimated_size('x'), 1u);
+  EXPECT_GE(strings::estimated_size(12345), 5u);
+  EXPECT_GE(strings::estimated_size(false), 5u);
+  EXPECT_GE(strings::estimated_size(1.5), 3u);
+  EXPECT_GE(strings::estimated_size(std::vector{"ab"sv, "cde"sv}), 5u);
+  EXPECT_GE(strings::estimated_size(std::pair{1, "ab"sv}), 3u);
+  // Creating functions reserve at least the final size up front.
+  const auto s = strings::concat("abc", 12345, "def"sv);
+  EXPECT_EQ(s, "abc12345def");
+  EXPECT_GE(s.capacity(), s.size());
+  const auto j = strings::join("abc"sv, 42, "def"sv);
+  EXPECT_EQ(j, "[abc, 42, def]");
+  EXPECT_GE(j.capacity(), j.size());
 }
 
 void StringUtilsTest_Append() {
@@ -1640,6 +2065,20 @@ void StringUtilsTest_Streams() {
     strings::append_join(s, a, b);
     EXPECT_EQ(s.str(), "[[1, 2, 3], [4, 5, 6]]");
   }
+  if (true) {
+    // Buffered streaming: formatted in the thread-local buffer, written in
+    // one piece.
+    std::stringstream s;
+    strings::buffered_out(s, "x="sv, 42, ';');
+    EXPECT_EQ(s.str(), "x=42;");
+  }
+  if (true) {
+    std::stringstream s;
+    strings::buffered_out_with(s, ", ", a, b);
+    EXPECT_EQ(s.str(), "[[1, 2, 3], [4, 5, 6]]");
+    strings::buffered_out_with<join_opt::flat>(s, "|", 7, 8, 9);
+    EXPECT_EQ(s.str(), "[[1, 2, 3], [4, 5, 6]]7|8|9");
+  }
 }
 
 enum class rgb {
@@ -1864,6 +2303,37 @@ void StringUtilsTest_AppendStream() {
   }
 }
 
+void StringUtilsTest_HashString() {
+  using strings::hash_string;
+  using strings::switch_hash;
+
+  // Known FNV-1a vectors, at compile time.
+  static_assert(hash_string("") == 0xcbf2'9ce4'8422'2325ull);
+  static_assert(hash_string("a") == 0xaf63'dc4c'8601'ec8cull);
+  static_assert(switch_hash<"abc">() == hash_string("abc"));
+  EXPECT_EQ(hash_string("abc"sv), hash_string("abc"));
+  EXPECT_NE(hash_string("abc"sv), hash_string("abd"sv));
+  // Seeding changes the result.
+  EXPECT_NE(hash_string("abc"sv, 1), hash_string("abc"sv));
+
+  // Keyword dispatch: one integer switch, one verify-compare per hit.
+  const auto dispatch = [](std::string_view key) {
+    switch (switch_hash(key)) {
+    case switch_hash<"get">():
+      if (key == "get") return 1;
+      break;
+    case switch_hash<"put">():
+      if (key == "put") return 2;
+      break;
+    }
+    return 0;
+  };
+  EXPECT_EQ(dispatch("get"), 1);
+  EXPECT_EQ(dispatch("put"), 2);
+  EXPECT_EQ(dispatch("post"), 0);
+  EXPECT_EQ(dispatch(""), 0);
+}
+
 void StringUtilsTest_AppendJson() {
   using strings::join_opt;
 
@@ -1899,11 +2369,90 @@ void StringUtilsTest_AppendJson() {
   }
 }
 
+void StringUtilsTest_Nocase() {
+  // Fold equality.
+  EXPECT_TRUE(strings::equal_nocase("AbC"sv, "aBc"sv));
+  EXPECT_FALSE(strings::equal_nocase("abc"sv, "abd"sv));
+  EXPECT_FALSE(strings::equal_nocase("abc"sv, "ab"sv));
+  static_assert(strings::equal_nocase("Abc", "aBC"));
+
+  // Char locate, both directions of the fold, and nothing for non-letters.
+  const auto s = "Content-Type: TEXT/HTML"s;
+  EXPECT_EQ(strings::locate_nocase(s, 'c'), 0u);
+  EXPECT_EQ(strings::locate_nocase(s, 'E', 1), 4u);
+  EXPECT_EQ(strings::locate_nocase(s, 'x'), 16u);
+  EXPECT_EQ(strings::locate_nocase(s, '-'), 7u);
+  EXPECT_EQ(strings::locate_nocase(s, 'z'), strings::npos);
+  static_assert(strings::locate_nocase("aBc"sv, 'B') == 1u);
+
+  // Folding doesn't confuse the bytes 0x20 apart from letters.
+  EXPECT_EQ(strings::locate_nocase("`@"sv, '@'), 1u);
+  EXPECT_EQ(strings::locate_nocase("@"sv, '`'), strings::npos);
+
+  // String locate.
+  EXPECT_EQ(strings::locate_nocase(s, "text"sv), 14u);
+  EXPECT_EQ(strings::locate_nocase(s, "content-type"sv), 0u);
+  EXPECT_EQ(strings::locate_nocase(s, "html"sv), 19u);
+  EXPECT_EQ(strings::locate_nocase(s, "xml"sv), strings::npos);
+  EXPECT_EQ(strings::locate_nocase(s, ""sv, 3), 3u);
+  static_assert(strings::locate_nocase("aBcDe"sv, "CDE"sv) == 2u);
+
+  // located loop.
+  size_t pos{};
+  size_t cnt{};
+  while (strings::located_nocase(pos, s, 't')) ++cnt, ++pos;
+  EXPECT_EQ(cnt, 6u);
+
+  // Substitution: matching folds, the replacement doesn't.
+  auto t = s;
+  EXPECT_EQ(strings::substitute_nocase(t, 'T', 'x'), 6u);
+  EXPECT_EQ(t, "Conxenx-xype: xEXx/HxML");
+  t = s;
+  EXPECT_EQ(strings::substitute_nocase(t, "text/html"sv, "json"sv), 1u);
+  EXPECT_EQ(t, "Content-Type: json");
+  t = s;
+  EXPECT_EQ(strings::substitute_nocase(t, "TYPE"sv, "size"sv), 1u);
+  EXPECT_EQ(t, "Content-size: TEXT/HTML");
+  t = s;
+  EXPECT_EQ(strings::substitute_nocase(t, "xml"sv, "yaml"sv), 0u);
+  EXPECT_EQ(t, s);
+}
+
+void StringUtilsTest_Perf() {
+  // Budget guards for the hot paths. The budgets are deliberately generous,
+  // so a pass proves little, but a failure means an order-of-magnitude
+  // regression; see `CORVID_PERF_TOLERANCE` in the shim for scaling them on
+  // slow machines.
+  const auto line = "alpha,beta,gamma,delta,epsilon,zeta,eta,theta"s;
+  size_t sink{};
+  EXPECT_FASTER_THAN(250ms, 10'000, [&] {
+    sink += strings::split(std::string_view{line}, ",").size();
+  });
+  EXPECT_EQ(sink % 8, 0u);
+
+  const auto haystack = std::string(1022, 'x') + "yz";
+  sink = 0;
+  EXPECT_FASTER_THAN(250ms, 10'000,
+      [&] { sink += strings::locate(haystack, 'y'); });
+  EXPECT_EQ(sink % 1022, 0u);
+
+  sink = 0;
+  EXPECT_FASTER_THAN(250ms, 10'000, [&] {
+    sink += strings::concat("abc", 12345, std::string_view{line}).size();
+  });
+  EXPECT_EQ(sink % 53, 0u);
+}
+
 MAKE_TEST_LIST(StringUtilsTest_ExtractPiece, StringUtilsTest_MorePieces,
     StringUtilsTest_Split, StringUtilsTest_SplitPg, StringUtilsTest_ParseNum,
-    StringUtilsTest_Case, StringUtilsTest_Locate, StringUtilsTest_RLocate,
+    StringUtilsTest_Case, StringUtilsTest_Locate,
+    StringUtilsTest_CompiledLocator, StringUtilsTest_RLocate,
     StringUtilsTest_LocateEdges, StringUtilsTest_Substitute,
-    StringUtilsTest_Excise, StringUtilsTest_Target, StringUtilsTest_Print,
-    StringUtilsTest_Trim, StringUtilsTest_AppendNum, StringUtilsTest_Append,
+    StringUtilsTest_Excise, StringUtilsTest_Target, StringUtilsTest_FdSink,
+    StringUtilsTest_Print,
+    StringUtilsTest_Trim, StringUtilsTest_AppendNum, StringUtilsTest_Codecs,
+    StringUtilsTest_EstimatedSize, StringUtilsTest_Append,
     StringUtilsTest_Edges, StringUtilsTest_Streams, StringUtilsTest_AppendEnum,
-    StringUtilsTest_AppendStream, StringUtilsTest_AppendJson);
+    StringUtilsTest_AppendStream, StringUtilsTest_AppendJson,
+    StringUtilsTest_HashString, StringUtilsTest_Nocase,
+    StringUtilsTest_Perf);
@@ -15,6 +15,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <thread>
+
 #include "../corvid/containers/timers.h"
 
 std::ostream&
@@ -119,4 +121,215 @@ void TimersTest_Edge() {
   EXPECT_EQ(ids.size(), 2u);
 }
 
-MAKE_TEST_LIST(TimersTest_General, TimersTest_Edge);
+void WheelTimersTest_General() {
+  wheel_timers t;
+  auto now = make_date(2024y / 1 / 1);
+  std::vector<timer_id_t> ids;
+  auto now_cb = [&now]() { return now; };
+  t.set_clock_callback(now_cb);
+  auto cb = [&ids](timer_event& event) { ids.push_back(event.timer_id); };
+
+  EXPECT_EQ(t.events().size(), 0u);
+
+  // A 30s delay lands in an outer wheel and cascades in on its way due.
+  auto& t1 = t.set(30s, cb);
+  auto id1 = t1.timer_id;
+  EXPECT_EQ(id1, timer_id_t{1});
+  auto& t2 = t.set(60s, cb);
+  auto id2 = t2.timer_id;
+  EXPECT_EQ(t.events().size(), 2u);
+
+  size_t count = 0;
+  count = t.tick();
+  EXPECT_EQ(count, 0u);
+  now += 29s;
+  count = t.tick();
+  EXPECT_EQ(count, 0u);
+  now += 1s;
+  count = t.tick();
+  EXPECT_EQ(count, 1u);
+  EXPECT_EQ(ids.size(), 1u);
+  EXPECT_EQ(ids[0], id1);
+  EXPECT_EQ(t.events().size(), 1u);
+  now += 30s;
+  count = t.tick();
+  EXPECT_EQ(count, 1u);
+  EXPECT_EQ(ids[1], id2);
+  EXPECT_EQ(t.events().size(), 0u);
+}
+
+void WheelTimersTest_Edge() {
+  wheel_timers t;
+  auto now = make_date(2024y / 1 / 1);
+  std::vector<timer_id_t> ids;
+  auto now_cb = [&now]() { return now; };
+  t.set_clock_callback(now_cb);
+  auto cb = [&ids](timer_event& event) { ids.push_back(event.timer_id); };
+
+  size_t count = 0;
+
+  // Repeating.
+  [[maybe_unused]] auto& t1 = t.set(30s, cb, 60s);
+  now += 30s;
+  count = t.tick();
+  EXPECT_EQ(count, 1u); // Fires at 30s.
+  now += 59s;
+  count = t.tick();
+  EXPECT_EQ(count, 0u);
+  now += 1s;
+  count = t.tick();
+  EXPECT_EQ(count, 1u); // Fires at 90s.
+  EXPECT_EQ(ids.size(), 2u);
+  EXPECT_EQ(t.events().size(), 1u);
+
+  // O(1) cancel: the stale slot entry is skipped when it comes due.
+  auto& t2 = t.set(10s, cb);
+  EXPECT_TRUE(t.cancel(t2.timer_id));
+  EXPECT_FALSE(t.cancel(timer_id_t{999}));
+  now += 10s;
+  count = t.tick();
+  EXPECT_EQ(count, 0u);
+
+  // `next_in` is a usable sleep hint: never later than the next event.
+  auto& t3 = t.set(5s, cb);
+  EXPECT_TRUE(t.next_in(1h) <= 5s);
+  now += t.next_in(1h);
+  while (!t.tick()) now += t.next_in(1h);
+  EXPECT_EQ(ids.back(), t3.timer_id);
+
+  // `max_callbacks` stops partway and the rest stay due.
+  t.set(1s, cb);
+  t.set(1s, cb);
+  t.set(1s, cb);
+  now += 1s;
+  EXPECT_EQ(t.tick(2), 2u);
+  EXPECT_EQ(t.tick(), 1u);
+  EXPECT_EQ(t.events().size(), 1u); // Just the repeating timer.
+}
+
+// Both engines coalesce identically, so test them the same way.
+template<typename TIMERS>
+void test_slack() {
+  TIMERS t;
+  auto now = make_date(2024y / 1 / 1);
+  std::vector<timer_id_t> ids;
+  auto now_cb = [&now]() { return now; };
+  t.set_clock_callback(now_cb);
+  auto cb = [&ids](timer_event& event) { ids.push_back(event.timer_id); };
+
+  // With 10s of slack, expirations at 28s and 30s round up to the same 30s
+  // batch boundary and deliver in one sweep.
+  auto& t1 = t.set(28s, cb, 0ms, 0ms, 10s);
+  auto& t2 = t.set(30s, cb, 0ms, 0ms, 10s);
+  EXPECT_EQ(t1.slack, 10s);
+  // Exact for `timers`; a lower bound for `wheel_timers`.
+  EXPECT_TRUE(t.next_at() <= now + 30s);
+  EXPECT_TRUE(t.next_at() > now);
+  if constexpr (std::is_same_v<TIMERS, timers>)
+    EXPECT_EQ(t.next_at(), now + 30s);
+  now += 29s;
+  EXPECT_EQ(t.tick(), 0u);
+  now += 1s;
+  EXPECT_EQ(t.tick(), 2u);
+  EXPECT_EQ(ids.size(), 2u);
+  (void)t2;
+
+  // Repeats coalesce too: firing at 30s, a 25s repeat lands on 60s.
+  ids.clear();
+  [[maybe_unused]] auto& t3 = t.set(now + 25s, cb, 25s, {}, 10s);
+  now += 30s;
+  EXPECT_EQ(t.tick(), 1u);
+  now += 25s;
+  EXPECT_EQ(t.tick(), 0u); // 85s: not due until the 90s boundary.
+  now += 5s;
+  EXPECT_EQ(t.tick(), 1u);
+  EXPECT_EQ(ids.size(), 2u);
+
+  // Zero slack remains exact.
+  [[maybe_unused]] auto& t4 = t.set(1s, cb);
+  now += 1s;
+  EXPECT_EQ(t.tick(), 1u);
+}
+
+void TimersTest_Slack() {
+  test_slack<timers>();
+}
+
+void WheelTimersTest_Slack() {
+  test_slack<wheel_timers>();
+}
+
+// Both engines shard identically, so test them the same way.
+template<typename TIMERS>
+void test_sharded() {
+  sharded_timers<TIMERS, 2> st;
+  auto now = make_date(2024y / 1 / 1);
+  auto now_cb = [&now]() { return now; };
+  st.set_clock_callback(now_cb);
+  std::vector<timer_id_t> fired0, fired1;
+  auto cb0 = [&fired0](timer_event& event) {
+    fired0.push_back(event.timer_id);
+  };
+  auto cb1 = [&fired1](timer_event& event) {
+    fired1.push_back(event.timer_id);
+  };
+
+  // Ids are minted immediately and carry the shard.
+  const auto id0 = st.set(0, 30s, cb0);
+  const auto id1 = st.set(1, 30s, cb1);
+  EXPECT_NE(id0, timer_id_t::invalid);
+  EXPECT_NE(id0, id1);
+  EXPECT_EQ(st.shard_of(id0), 0u);
+  EXPECT_EQ(st.shard_of(id1), 1u);
+
+  // Requests sit in the inbox until the owning thread drains, which
+  // `next_in` does; the engine id matches the minted one.
+  EXPECT_EQ(st.shard(0).events().size(), 0u);
+  // Exact for `timers`; a lower bound for `wheel_timers`.
+  const auto in0 = st.next_in(0, 1h);
+  EXPECT_TRUE(in0 > 0ms && in0 <= 30s);
+  if constexpr (std::is_same_v<TIMERS, timers>) EXPECT_EQ(in0, 30s);
+  EXPECT_EQ(st.shard(0).events().size(), 1u);
+  EXPECT_EQ(st.event(id0).timer_id, id0);
+  (void)st.next_in(1, 1h);
+
+  now += 30s;
+  EXPECT_EQ(st.tick(0), 1u);
+  EXPECT_EQ(st.tick(1), 1u);
+  EXPECT_EQ(fired0.size(), 1u);
+  EXPECT_EQ(fired0[0], id0);
+  EXPECT_EQ(fired1.size(), 1u);
+  EXPECT_EQ(fired1[0], id1);
+
+  // Cancel routes itself by the id's shard bits.
+  const auto id2 = st.set(1, 30s, cb1);
+  EXPECT_TRUE(st.cancel(id2));
+  now += 30s;
+  EXPECT_EQ(st.tick(1), 0u);
+  EXPECT_EQ(st.shard(1).events().size(), 0u);
+  EXPECT_FALSE(st.cancel(timer_id_t::invalid));
+
+  // A worker thread arms a timer cross-thread; the owner fires it.
+  timer_id_t worker_id{};
+  std::thread worker{[&st, &cb0, &worker_id, at = now + 5s] {
+    worker_id = st.set(0, at, cb0);
+  }};
+  worker.join();
+  (void)st.next_in(0, 1h); // Drain before the due time passes.
+  now += 5s;
+  EXPECT_EQ(st.tick(0), 1u);
+  EXPECT_EQ(fired0.size(), 2u);
+  EXPECT_EQ(fired0[1], worker_id);
+}
+
+void ShardedTimersTest_General() {
+  test_sharded<timers>();
+}
+
+void ShardedWheelTimersTest_General() {
+  test_sharded<wheel_timers>();
+}
+
+MAKE_TEST_LIST(TimersTest_General, TimersTest_Edge, TimersTest_Slack,
+    WheelTimersTest_General, WheelTimersTest_Edge, WheelTimersTest_Slack,
+    ShardedTimersTest_General, ShardedWheelTimersTest_General);